@@ -0,0 +1,274 @@
+// Board microbenchmarks and perft.
+//
+//   board-bench            time the core Board operations on 9x9, 13x13 and
+//                          19x19 and verify perft counts
+//   board-bench --perft    only verify perft counts (exit status 1 on mismatch)
+//
+// Perft counts the positions reachable in exactly N actions (placements and
+// passes) from a start position. The reference counts below were produced by
+// the current move generator; any change to legality, captures, ko or phase
+// handling shows up as a mismatch.
+
+#include "double-go/double-go.h"
+#include "double-go/rollout.h"
+#include "double-go/search.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace double_go;
+
+namespace {
+
+// Deterministic across platforms, unlike the standard distributions.
+struct SplitMix64 {
+  uint64_t state;
+  uint64_t next() {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+  int below(int n) { return static_cast<int>(next() % n); }
+};
+
+volatile uint64_t sink;
+
+// ── Perft ───────────────────────────────────────────────────────────────────
+
+uint64_t perft(const Board &board, int depth) {
+  if (depth == 0)
+    return 1;
+  if (board.game_over())
+    return 0;
+  uint64_t nodes = 0;
+  for (Action a : board.legal_actions()) {
+    Board next = board;
+    if (!next.apply(a)) {
+      std::fprintf(stderr, "legal action rejected by apply\n");
+      return 0;
+    }
+    nodes += perft(next, depth - 1);
+  }
+  return nodes;
+}
+
+// Plays n pseudo-random actions from an empty board.
+Board random_position(int size, int n, uint64_t seed) {
+  Board b(size);
+  SplitMix64 rng{seed};
+  for (int i = 0; i < n && !b.game_over(); ++i) {
+    auto actions = b.legal_actions();
+    b.apply(actions[rng.below(static_cast<int>(actions.size()))]);
+  }
+  return b;
+}
+
+struct PerftCase {
+  const char *name;
+  int size;
+  int random_moves; // 0: empty board
+  int depth;
+  uint64_t expected;
+};
+
+const PerftCase PERFT_CASES[] = {
+    {"5x5 empty", 5, 0, 1, 26},
+    {"5x5 empty", 5, 0, 2, 651},
+    {"5x5 empty", 5, 0, 3, 15642},
+    {"5x5 empty", 5, 0, 4, 361482},
+    {"9x9 empty", 9, 0, 3, 531514},
+    {"19x19 empty", 19, 0, 2, 130683},
+    {"9x9 opening", 9, 30, 3, 130261},
+    {"9x9 midgame", 9, 60, 3, 10123},
+    {"5x5 endgame", 5, 20, 4, 977},
+    {"5x5 endgame", 5, 20, 6, 22581},
+};
+
+bool run_perft() {
+  bool ok = true;
+  for (const auto &c : PERFT_CASES) {
+    Board start = c.random_moves ? random_position(c.size, c.random_moves, 7)
+                                 : Board(c.size);
+    auto t0 = std::chrono::steady_clock::now();
+    uint64_t nodes = perft(start, c.depth);
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                             t0)
+                   .count();
+    bool match = nodes == c.expected;
+    ok &= match;
+    std::printf("perft %-12s depth %d: %10llu %s (%.0f nodes/s)\n", c.name,
+                c.depth, static_cast<unsigned long long>(nodes),
+                match ? "ok" : "MISMATCH", nodes / s);
+  }
+  return ok;
+}
+
+// ── Timings ─────────────────────────────────────────────────────────────────
+
+// Repeats one round of work until at least MIN_SECONDS have passed. round()
+// returns the number of operations it performed.
+constexpr double MIN_SECONDS = 0.5;
+
+template <typename F> void measure(const char *what, int size, F &&round) {
+  auto start = std::chrono::steady_clock::now();
+  double ops = 0, seconds = 0;
+  do {
+    ops += round();
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                            start)
+                  .count();
+  } while (seconds < MIN_SECONDS);
+  std::printf("  %-20s %2dx%-2d %14.0f ops/s %10.1f ns/op\n", what, size,
+              size, ops / seconds, seconds * 1e9 / ops);
+}
+
+// Flat priors and a neutral value at no cost, so search measures time the
+// tree alone: selection, replaying the path and expansion.
+class FlatEvaluator : public Evaluator {
+public:
+  Evaluation evaluate(const std::deque<Board> &history) override {
+    int n = history.back().size() * history.back().size() + 1;
+    return {std::vector<float>(n, 1.0f), 0.0f};
+  }
+};
+
+// Random games recorded as action lists, plus every fourth position along
+// the way and the final position of each game.
+struct Corpus {
+  std::vector<std::vector<Action>> games;
+  std::vector<Board> positions;
+  std::vector<Board> finals;
+};
+
+Corpus make_corpus(int size, int num_games) {
+  Corpus corpus;
+  SplitMix64 rng{static_cast<uint64_t>(size)};
+  int max_moves = 4 * size * size;
+  for (int g = 0; g < num_games; ++g) {
+    Board b(size);
+    std::vector<Action> actions;
+    while (!b.game_over() && static_cast<int>(actions.size()) < max_moves) {
+      auto legal = b.legal_actions();
+      Action a = legal[rng.below(static_cast<int>(legal.size()))];
+      b.apply(a);
+      actions.push_back(a);
+      if (actions.size() % 4 == 0)
+        corpus.positions.push_back(b);
+    }
+    corpus.games.push_back(std::move(actions));
+    corpus.finals.push_back(b);
+  }
+  return corpus;
+}
+
+void bench_size(int size) {
+  const Corpus corpus = make_corpus(size, 8);
+  const int max_moves = 4 * size * size;
+  SplitMix64 rng{42};
+  uint64_t acc = 0;
+
+  measure("apply (incl. hash)", size, [&] {
+    double ops = 0;
+    for (const auto &game : corpus.games) {
+      Board b(size);
+      for (Action a : game)
+        acc += b.apply(a);
+      ops += game.size();
+      acc ^= b.hash();
+    }
+    return ops;
+  });
+  measure("is_legal", size, [&] {
+    for (const auto &b : corpus.positions)
+      for (int row = 0; row < size; ++row)
+        for (int col = 0; col < size; ++col)
+          acc += b.is_legal({row, col});
+    return double(corpus.positions.size()) * size * size;
+  });
+  measure("legal_actions", size, [&] {
+    for (const auto &b : corpus.positions)
+      acc += b.legal_actions().size();
+    return double(corpus.positions.size());
+  });
+  measure("score", size, [&] {
+    for (const auto &b : corpus.positions)
+      acc += static_cast<uint64_t>(b.score(7.5).black_score);
+    return double(corpus.positions.size());
+  });
+  // End-of-playout positions, the case rollouts actually score.
+  measure("score (final)", size, [&] {
+    for (const auto &b : corpus.finals)
+      acc += static_cast<uint64_t>(b.score(7.5).black_score);
+    return double(corpus.finals.size());
+  });
+  // Hashing from scratch, for comparison with the incremental updates folded
+  // into apply above.
+  measure("hash from scratch", size, [&] {
+    for (const auto &b : corpus.positions)
+      acc ^= b.compute_hash();
+    return double(corpus.positions.size());
+  });
+  double playout_moves = 0, playouts = 0;
+  measure("random playout", size, [&] {
+    Board b(size);
+    int n = 0;
+    while (!b.game_over() && n < max_moves) {
+      auto legal = b.legal_actions();
+      b.apply(legal[rng.below(static_cast<int>(legal.size()))]);
+      ++n;
+    }
+    acc ^= b.hash();
+    playout_moves += n;
+    playouts += 1;
+    return 1.0;
+  });
+  std::printf("  %-20s %2dx%-2d %14.1f moves/playout\n", "", size, size,
+              playout_moves / playouts);
+  // Pattern policy playouts with incremental feature and sampler updates.
+  RolloutBot rollout(nullptr, 42);
+  measure("rollout playout", size, [&] {
+    acc ^= rollout.playout(Board(size), max_moves).hash();
+    return 1.0;
+  });
+  SearchConfig config;
+  config.visits = 800;
+  Search search(std::make_shared<FlatEvaluator>(), config);
+  SearchResult last;
+  measure("search (flat eval)", size, [&] {
+    last = search.run({Board(size)});
+    return double(config.visits);
+  });
+  std::printf("  %-20s %2dx%-2d %14.1f bytes/node (%zu nodes, %zu edges)\n",
+              "", size, size, double(last.tree_bytes) / last.tree_nodes,
+              last.tree_nodes, last.tree_edges);
+  // Share of a rollout search's visits that early stop saves, over
+  // positions from the random games.
+  config.visits = 200;
+  config.early_stop = true;
+  Search early(std::make_shared<RolloutEvaluator>(nullptr, 6.5, 7), config);
+  size_t step = std::max<size_t>(1, corpus.positions.size() / 16);
+  double saved = 0, searches = 0;
+  for (size_t i = 0; i < corpus.positions.size(); i += step, searches++)
+    saved += early.run({corpus.positions[i]}).saved_visits;
+  std::printf("  %-20s %2dx%-2d %14.1f%% visits saved\n", "search (early stop)",
+              size, size, 100 * saved / (searches * config.visits));
+  sink = acc;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  bool perft_only = argc > 1 && std::strcmp(argv[1], "--perft") == 0;
+  bool ok = run_perft();
+  if (!perft_only) {
+    for (int size : {9, 13, 19}) {
+      std::printf("%dx%d\n", size, size);
+      bench_size(size);
+    }
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+// Model inference benchmark.
+//
+// Measures Model::encode and Model::forward for every combination of the
+// given board sizes, architectures, batch sizes and intra-op thread counts,
+// and prints one JSON document to stdout for regression tracking:
+//
+//   {"benchmark": "model", "results": [{"board_size": 9, ...}, ...]}
+//
+// Latencies are per call in microseconds: encode is one position, forward is
+// one batch. positions_per_sec covers encode plus forward.
+
+#include "double-go/model.h"
+
+#include <torch/version.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace double_go;
+
+namespace {
+
+void usage(const char *prog) {
+  std::fprintf(stderr,
+               "usage: %s [--sizes N,...] [--blocks N,...] [--channels N,...]\n"
+               "          [--batches N,...] [--threads N,...] [--iters N]\n"
+               "          [--warmup N] [--unfused]\n",
+               prog);
+}
+
+std::vector<int> parse_list(const char *s) {
+  std::vector<int> out;
+  std::stringstream ss(s);
+  std::string item;
+  while (std::getline(ss, item, ','))
+    out.push_back(std::atoi(item.c_str()));
+  return out;
+}
+
+struct Percentiles {
+  double p50;
+  double p99;
+};
+
+Percentiles percentiles(std::vector<double> samples) {
+  std::sort(samples.begin(), samples.end());
+  auto at = [&](double q) {
+    size_t i = static_cast<size_t>(q * (samples.size() - 1) + 0.5);
+    return samples[i];
+  };
+  return {at(0.50), at(0.99)};
+}
+
+double micros_since(std::chrono::steady_clock::time_point t0) {
+  return std::chrono::duration<double, std::micro>(
+             std::chrono::steady_clock::now() - t0)
+      .count();
+}
+
+// A few game histories with stones on the board, so encode does real work.
+std::vector<std::deque<Board>> make_histories(int size, int count) {
+  std::mt19937 rng(size);
+  std::vector<std::deque<Board>> histories;
+  for (int h = 0; h < count; ++h) {
+    std::deque<Board> history{Board(size)};
+    for (int m = 0; m < size * size / 2 && !history.back().game_over(); ++m) {
+      auto actions = history.back().legal_actions();
+      Board next = history.back();
+      next.apply(actions[rng() % actions.size()]);
+      history.push_back(std::move(next));
+      if (history.size() > Model::HISTORY_LEN)
+        history.pop_front();
+    }
+    histories.push_back(std::move(history));
+  }
+  return histories;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::vector<int> sizes = {9, 19};
+  std::vector<int> blocks = {6};
+  std::vector<int> channels = {64};
+  std::vector<int> batches = {1, 8, 32};
+  std::vector<int> threads = {1};
+  int iters = 50;
+  int warmup = 5;
+  bool fused = true;
+
+  for (int i = 1; i < argc; ++i) {
+    auto flag = [&](const char *name) {
+      return std::strcmp(argv[i], name) == 0 && i + 1 < argc;
+    };
+    if (flag("--sizes")) {
+      sizes = parse_list(argv[++i]);
+    } else if (flag("--blocks")) {
+      blocks = parse_list(argv[++i]);
+    } else if (flag("--channels")) {
+      channels = parse_list(argv[++i]);
+    } else if (flag("--batches")) {
+      batches = parse_list(argv[++i]);
+    } else if (flag("--threads")) {
+      threads = parse_list(argv[++i]);
+    } else if (flag("--iters")) {
+      iters = std::max(1, std::atoi(argv[++i]));
+    } else if (flag("--warmup")) {
+      warmup = std::atoi(argv[++i]);
+    } else if (std::strcmp(argv[i], "--unfused") == 0) {
+      fused = false;
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  torch::NoGradGuard no_grad;
+  std::printf("{\"benchmark\": \"model\", \"torch\": \"%s\", \"results\": [",
+              TORCH_VERSION);
+  bool first = true;
+
+  for (int size : sizes) {
+    auto histories = make_histories(size, 64);
+    for (int nb : blocks) {
+      for (int nc : channels) {
+        Model model(size, nb, nc);
+        model.eval();
+        if (fused)
+          model.fuse();
+
+        for (int nt : threads) {
+          torch::set_num_threads(nt);
+          for (int batch : batches) {
+            std::vector<double> encode_us, forward_us;
+            double total_us = 0;
+            for (int it = 0; it < warmup + iters; ++it) {
+              std::vector<Tensor> encodings;
+              encodings.reserve(batch);
+              auto t0 = std::chrono::steady_clock::now();
+              for (int b = 0; b < batch; ++b) {
+                const auto &history =
+                    histories[(it * batch + b) % histories.size()];
+                auto e0 = std::chrono::steady_clock::now();
+                encodings.push_back(model.encode(history));
+                if (it >= warmup)
+                  encode_us.push_back(micros_since(e0));
+              }
+              auto input = torch::stack(encodings);
+              auto f0 = std::chrono::steady_clock::now();
+              auto [policy, value] = model.forward(input);
+              // Touch the outputs so lazy backends finish the work.
+              policy.sum().item<float>();
+              value.sum().item<float>();
+              if (it >= warmup) {
+                forward_us.push_back(micros_since(f0));
+                total_us += micros_since(t0);
+              }
+            }
+
+            auto enc = percentiles(encode_us);
+            auto fwd = percentiles(forward_us);
+            double pps = iters * batch / (total_us * 1e-6);
+            std::printf(
+                "%s\n  {\"board_size\": %d, \"num_blocks\": %d, "
+                "\"num_channels\": %d, \"batch_size\": %d, \"threads\": %d, "
+                "\"fused\": %s, \"iters\": %d, "
+                "\"encode_us\": {\"p50\": %.2f, \"p99\": %.2f}, "
+                "\"forward_us\": {\"p50\": %.2f, \"p99\": %.2f}, "
+                "\"positions_per_sec\": %.1f}",
+                first ? "" : ",", size, nb, nc, batch, nt,
+                fused ? "true" : "false", iters, enc.p50, enc.p99, fwd.p50,
+                fwd.p99, pps);
+            std::fflush(stdout);
+            first = false;
+          }
+        }
+      }
+    }
+  }
+  std::printf("\n]}\n");
+  return 0;
+}
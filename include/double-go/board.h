@@ -5,6 +5,7 @@
 #include <array>
 #include <cstdint>
 #include <cstring>
+#include <memory>
 #include <optional>
 #include <random>
 #include <vector>
@@ -20,6 +21,41 @@ struct ScoreResult {
   double white_score;
 };
 
+enum class SuperkoRule : uint8_t {
+  None,
+  // A placement may not recreate any earlier arrangement of stones.
+  Positional,
+  // A placement may not recreate an arrangement of stones that the same
+  // player created before.
+  Situational,
+};
+
+// Keys of the positions seen so far in a game, for superko checks. Open
+// addressing keeps lookups O(1) and allocation-free. Every insertion is
+// logged, so search can mark() before exploring a line and rollback() to the
+// mark afterwards in time proportional to the moves undone.
+class PositionHistory {
+public:
+  explicit PositionHistory(size_t expected_positions = 512);
+
+  bool contains(uint64_t key) const;
+  void insert(uint64_t key);
+  size_t size() const { return count_; }
+
+  size_t mark() const { return log_.size(); }
+  void rollback(size_t mark);
+
+private:
+  static uint64_t slot_key(uint64_t key) { return key ? key : 1; }
+  size_t find_slot(uint64_t key) const;
+  void grow();
+
+  std::vector<uint64_t> slots_; // 0 marks an empty slot
+  // Inserted keys in order; 0 records an insertion of a key already present.
+  std::vector<uint64_t> log_;
+  size_t count_ = 0;
+};
+
 class Board {
 public:
   explicit Board(int size = 19);
@@ -40,13 +76,35 @@ public:
   std::vector<Point> legal_moves() const;
   std::vector<Action> legal_actions() const;
 
+  // Enforces the given superko rule from now on, recording the current
+  // position as the first entry of the history. Copies of this board share
+  // the history, so every board in one game sees the same positions. Code
+  // that explores hypothetical lines on copies (search, playouts) must
+  // mark() the history first and rollback() afterwards.
+  void enable_superko(SuperkoRule rule,
+                      std::shared_ptr<PositionHistory> history = nullptr);
+  SuperkoRule superko_rule() const { return superko_rule_; }
+  const std::shared_ptr<PositionHistory> &position_history() const {
+    return position_history_;
+  }
+
   bool apply(Action a);
   // Plays a single move and ends turn, if currently in the First phase.
   // Otherwise, the move is not played. Returns true if a legal move was played.
   bool play_single(Point p);
   void pass();
 
+  // Full-state hash for transpositions: stones, ko point, side to move and
+  // phase. Capture counts and the pass count are left out, since area
+  // scoring and legality do not depend on them.
   uint64_t hash() const { return hash_; }
+  // Hash of the stones alone, ignoring ko, side to move and phase. Used for
+  // superko and for caching evaluations of the same arrangement.
+  uint64_t stone_hash() const { return stone_hash_; }
+  // Recompute the hashes above from the board contents, for checking the
+  // incremental updates.
+  uint64_t compute_hash() const;
+  uint64_t compute_stone_hash() const;
 
   Color at_index(int i) const { return grid_[i]; }
 
@@ -60,6 +118,9 @@ private:
   void remove_group(Point p);
   void flood(Point p, Color color, std::vector<bool> &visited,
              int &lib_count) const;
+  bool is_legal_ignoring_superko(Point p) const;
+  uint64_t superko_key(uint64_t stones, Color mover) const;
+  uint64_t superko_key_after(Point p) const;
   void apply_move(Point p);
   void clear_ko();
   void set_ko(Point p);
@@ -73,8 +134,11 @@ private:
   int white_captures_ = 0;
   Phase phase_ = Phase::First;
   int consecutive_passes_ = 0;
+  SuperkoRule superko_rule_ = SuperkoRule::None;
+  std::shared_ptr<PositionHistory> position_history_;
 
   uint64_t hash_;
+  uint64_t stone_hash_ = 0;
 };
 
 class ZobristHash {
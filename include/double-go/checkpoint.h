@@ -0,0 +1,55 @@
+#pragma once
+
+#include "model.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace double_go {
+
+// Checkpoint file layout (little-endian):
+//
+//   header   magic "DGOCKPT", format version, architecture metadata and the
+//            number of tensors
+//   index    per tensor: name, dtype, shape, offset and size of its data
+//   data     raw tensor contents, each aligned to CHECKPOINT_ALIGNMENT so
+//            the file can be mapped and used in place
+//
+// Readers reject files with a newer major version than they understand.
+
+inline constexpr uint32_t CHECKPOINT_VERSION = 1;
+inline constexpr uint64_t CHECKPOINT_ALIGNMENT = 64;
+
+struct CheckpointInfo {
+  uint32_t version;
+  int board_size;
+  int num_blocks;
+  int num_channels;
+  int history_len;
+};
+
+struct LoadOptions {
+  // Fold batch norms for inference. Leave off to resume training. The
+  // folded convolutions get freshly allocated weights.
+  bool fuse = true;
+  // Map the file read-only and let the OS page weights in on first use
+  // instead of reading everything up front. Mapped weights cannot be
+  // written, so turn this off to train the loaded model.
+  bool mmap = true;
+};
+
+// Writes the model's parameters and batch norm statistics. Fused models are
+// rejected, since their batch norms can no longer be recovered.
+void save_checkpoint(const Model &model, const std::string &path);
+
+// Reads only the header. Throws std::runtime_error on malformed files.
+CheckpointInfo read_checkpoint_info(const std::string &path);
+
+// Builds a model with the recorded architecture and loads its weights. The
+// model is returned in eval mode. Throws std::runtime_error on malformed
+// files or unsupported versions.
+std::shared_ptr<Model> load_checkpoint(const std::string &path,
+                                       const LoadOptions &options = {});
+
+} // namespace double_go
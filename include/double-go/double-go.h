@@ -3,6 +3,7 @@
 #include "types.h"
 #include "board.h"
 #include "bot.h"
+#include "life.h"
 
 namespace double_go {
 
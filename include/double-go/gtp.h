@@ -0,0 +1,95 @@
+#pragma once
+
+#include "board.h"
+#include "rollout.h"
+#include "search.h"
+#include "time_manager.h"
+
+#include <deque>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace double_go {
+
+// GTP vertices: columns A to T skipping I, rows numbered from 1 at the
+// bottom of the board (row size - 1 here), and "pass". Case-insensitive.
+std::optional<Action> parse_vertex(const std::string &text, int size);
+std::string format_vertex(Action a, int size);
+
+struct GtpConfig {
+  int board_size = 19;
+  double komi = 6.5;
+  SuperkoRule superko = SuperkoRule::None;
+  // Without a clock, genmove searches until search.visits or move_time
+  // seconds, whichever comes first. A move_time of 0 searches the full
+  // visits. Once time_settings sets a clock, time decides instead of
+  // move_time.
+  SearchConfig search;
+  double move_time = 1.0;
+  TimeConfig time;
+  std::shared_ptr<const RolloutWeights> weights; // null: default weights
+  unsigned seed = 0;                             // 0: nondeterministic
+};
+
+// A Go Text Protocol engine for Double Go. The standard commands work as
+// usual except that the color given to play and genmove must be the side
+// to move: a turn is one or two stones, plus a bonus stone after the
+// opponent's double, so colors do not simply alternate. Extensions:
+//
+//   dg-phase            side to move and phase, e.g. "black second"
+//   dg-genturn COLOR    plays COLOR's whole turn, returning its stones
+//                       separated by spaces
+//
+// Under time_settings the engine keeps both clocks itself, charging every
+// stone it generates, and time_left corrects them.
+class GtpEngine {
+public:
+  explicit GtpEngine(GtpConfig config = {});
+
+  // Runs one command line and returns the response, terminated by the
+  // blank line GTP requires. Empty and comment lines produce nothing.
+  std::string execute(const std::string &line);
+  bool quit_requested() const { return quit_; }
+
+  // Answers commands from in until quit or end of input, flushing each
+  // response.
+  void run(std::istream &in, std::ostream &out);
+
+  const Board &board() const { return history_.back(); }
+
+  const TimeControl &time_control() const { return time_control_; }
+  const ClockState &clock(Color c) const {
+    return clocks_[c == Color::Black ? 0 : 1];
+  }
+
+private:
+  // Each command returns true on success with the response text in out,
+  // or false with the error message in out.
+  bool dispatch(const std::string &command,
+                const std::vector<std::string> &args, std::string &out);
+  bool play(const std::vector<std::string> &args, std::string &out);
+  bool genmove(const std::vector<std::string> &args, bool whole_turn,
+               std::string &out);
+  std::optional<Color> parse_color(const std::string &text) const;
+  void clear_board();
+  // Searches the stone to play, for the side to move.
+  Action think();
+  std::string showboard() const;
+
+  GtpConfig config_;
+  std::deque<Board> history_;
+  std::vector<size_t> superko_marks_; // history mark before each move
+  std::unique_ptr<MctsBot> bot_;
+  unsigned next_seed_;
+  bool quit_ = false;
+
+  TimeControl time_control_;
+  ClockState clocks_[2];
+  TimeManager time_manager_;
+};
+
+} // namespace double_go
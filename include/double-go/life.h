@@ -0,0 +1,54 @@
+#pragma once
+
+#include "board.h"
+
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace double_go {
+
+// ── Unconditional life ──────────────────────────────────────────────────────
+
+// Result of Benson's algorithm for both colors. A chain is pass-alive when
+// the opponent cannot capture it even if its owner never moves again; the
+// opponent playing two stones a turn does not change that, so the analysis
+// holds for Double Go as it does for Go.
+struct LifeStatus {
+  // Per point, row-major: the color that owns the point however the game
+  // continues (a pass-alive stone, or territory enclosed by pass-alive
+  // chains, dead stones included), or Empty while it is still open.
+  std::vector<Color> owner;
+  int black_points = 0;
+  int white_points = 0;
+};
+
+LifeStatus pass_alive(const Board &board);
+
+// Area score with pass-alive territory credited to its owner and the
+// opponent stones inside it removed as dead. Open points are scored as
+// Board::score does.
+ScoreResult score_pass_alive(const Board &board, const LifeStatus &life,
+                             double komi);
+
+// The winner, if no continuation can change it: even when every open point
+// goes to the trailing side, the leader's pass-alive points are enough.
+std::optional<Color> settled_winner(const LifeStatus &life, double komi);
+
+// ── Dead-stone estimation ───────────────────────────────────────────────────
+
+// Plays random playouts from the position (never filling single-point eyes)
+// and returns, per point, the fraction of playouts in which Black owned it
+// minus the fraction in which White did: +1 is always Black's, -1 always
+// White's. Superko history on the board is rolled back after each playout.
+std::vector<float> estimate_ownership(const Board &board, int playouts,
+                                      std::mt19937 &rng);
+
+// Area score after removing stones whose estimated owner is the opponent
+// with at least the given confidence, for scoring games that stopped before
+// dead stones were captured.
+ScoreResult score_with_dead_stones(const Board &board,
+                                   const std::vector<float> &ownership,
+                                   double komi, float threshold = 0.5f);
+
+} // namespace double_go
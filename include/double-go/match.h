@@ -0,0 +1,139 @@
+#pragma once
+
+#include "board.h"
+
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace double_go {
+
+// Chooses an action for the side to move. history.back() is the current
+// position; earlier entries are the positions after each previous action.
+using Player = std::function<Action(const std::deque<Board> &history)>;
+
+// Builds a fresh player for one game played under komi. Each game runs on a
+// single thread, so players need not be thread-safe; anything shared between
+// them must be.
+using PlayerFactory = std::function<Player(unsigned seed, double komi)>;
+
+struct GameResult {
+  Color winner; // Empty on a draw
+  double black_score;
+  double white_score;
+  int num_moves;
+  bool finished; // ended by two passes or adjudication, not the move limit
+  bool settled;  // stopped early because the winner was already decided
+  // The actions played, illegal ones replaced by the pass played instead.
+  std::vector<Action> actions;
+};
+
+// Plays one game to completion or max_moves actions, whichever comes first,
+// and scores the final position. Illegal actions are played as passes. With
+// stop_when_settled the game also ends as soon as pass-alive stones and
+// territory decide the winner, and is scored with dead stones removed.
+GameResult play_game(const Player &black, const Player &white, int board_size,
+                     double komi, int max_moves,
+                     SuperkoRule superko = SuperkoRule::None,
+                     bool stop_when_settled = false);
+
+struct MatchConfig {
+  int board_size = 9;
+  int num_games = 100;
+  int num_threads = 0; // 0: one per core
+  int max_moves = 0;   // 0: 4 * board_size * board_size
+  // Game i uses komis[(i / 2) % komis.size()] with colors swapped between
+  // i and i + 1, so every komi is played from both sides.
+  std::vector<double> komis = {6.5};
+  unsigned seed = 0; // 0: nondeterministic
+  SuperkoRule superko = SuperkoRule::None;
+  bool stop_when_settled = false; // see play_game
+};
+
+struct MatchGame {
+  int index;
+  bool a_is_black;
+  double komi;
+  GameResult result;
+
+  // 1 for an a win, 0.5 for a draw, 0 for a loss.
+  double score_for_a() const;
+};
+
+// Plays games between players a and b across threads. on_game is called once
+// per game, from one thread at a time, in completion order. Returning false
+// stops the match: no new games are started and games still in flight are
+// discarded.
+void run_match(const PlayerFactory &a, const PlayerFactory &b,
+               const MatchConfig &config,
+               const std::function<bool(const MatchGame &)> &on_game);
+
+// ── Statistics ──────────────────────────────────────────────────────────────
+
+// Running totals over a match, from player a's point of view.
+struct MatchSummary {
+  int wins = 0;
+  int draws = 0;
+  int losses = 0;
+  int wins_as_black = 0;
+  int games_as_black = 0;
+  int unfinished = 0; // stopped by the move limit
+  int settled = 0;    // stopped early with the winner decided
+  double margin_sum = 0.0;    // a's score minus b's, komi included
+  double margin_sq_sum = 0.0;
+  std::vector<int> game_lengths;
+
+  void add(const MatchGame &game);
+  int games() const { return wins + draws + losses; }
+  long long total_moves() const;
+  double mean_margin() const;
+  double margin_stddev() const;
+  // Game length at quantile q in [0, 1], by nearest rank.
+  int length_percentile(double q) const;
+};
+
+struct WinRate {
+  double score; // (wins + draws / 2) / games
+  double lower;
+  double upper;
+};
+
+// Wilson score interval for the match score at the given normal quantile
+// (1.96 for 95%).
+WinRate win_rate(int wins, int draws, int losses, double z = 1.96);
+
+// Elo difference corresponding to an expected score in (0, 1).
+double score_to_elo(double score);
+
+// Sequential probability ratio test of H0: elo = elo0 against H1: elo = elo1,
+// using the normal approximation to the trinomial log-likelihood ratio.
+// Stops as soon as either hypothesis is accepted at the requested error
+// rates, which typically needs far fewer games than a fixed-length match.
+class Sprt {
+public:
+  enum class Status { Continue, AcceptH0, AcceptH1 };
+
+  Sprt(double elo0, double elo1, double alpha = 0.05, double beta = 0.05);
+
+  void add(double score);
+  double llr() const;
+  double lower_bound() const { return lower_; }
+  double upper_bound() const { return upper_; }
+  Status status() const;
+
+  int wins() const { return wins_; }
+  int draws() const { return draws_; }
+  int losses() const { return losses_; }
+  int games() const { return wins_ + draws_ + losses_; }
+
+private:
+  double score0_;
+  double score1_;
+  double lower_;
+  double upper_;
+  int wins_ = 0;
+  int draws_ = 0;
+  int losses_ = 0;
+};
+
+} // namespace double_go
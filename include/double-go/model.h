@@ -3,6 +3,7 @@
 #include "board.h"
 #include <deque>
 #include <memory>
+#include <random>
 #include <sstream>
 #include <torch/torch.h>
 
@@ -26,7 +27,13 @@ struct ResidualBlock : nn::Module {
         bn1(register_module("bn1", nn::BatchNorm2d(channels))),
         bn2(register_module("bn2", nn::BatchNorm2d(channels))) {}
 
+  // Set once the batch norms have been folded into the convolutions.
+  bool fused = false;
+
   Tensor forward(Tensor x) {
+    if (fused) {
+      return relu(conv2(relu(conv1(x))) + x);
+    }
     Tensor residual = bn2(conv2(relu(bn1(conv1(x)))));
     return relu(residual + x);
   }
@@ -44,7 +51,12 @@ struct PolicyHead : nn::Module {
         fc(register_module("fc", nn::Linear(2 * board_size * board_size,
                                             board_size * board_size + 1))) {}
 
-  Tensor forward(Tensor x) { return fc(relu(bn(conv(x))).flatten(1)); }
+  bool fused = false;
+
+  Tensor forward(Tensor x) {
+    Tensor h = fused ? conv(x) : bn(conv(x));
+    return fc(relu(h).flatten(1));
+  }
 };
 
 struct ValueHead : nn::Module {
@@ -60,8 +72,11 @@ struct ValueHead : nn::Module {
         fc1(register_module("fc1", nn::Linear(board_size * board_size, 256))),
         fc2(register_module("fc2", nn::Linear(256, 1))) {}
 
+  bool fused = false;
+
   Tensor forward(Tensor x) {
-    return tanh(fc2(relu(fc1(relu(bn(conv(x))).flatten(1)))));
+    Tensor h = fused ? conv(x) : bn(conv(x));
+    return tanh(fc2(relu(fc1(relu(h).flatten(1)))));
   }
 };
 
@@ -105,6 +120,20 @@ struct Model : nn::Module {
     Tensor value = value_head->forward(features);
     return {policy, value};
   }
+
+  // Switches to eval mode and folds every batch norm into the convolution in
+  // front of it. Fused models are inference-only; they can no longer train.
+  void fuse();
+  bool is_fused() const { return value_head->fused; }
 };
 
-} // namespace double_go
\ No newline at end of file
+// Copies parameters and buffers (batch norm statistics) between two models of
+// the same architecture.
+void copy_weights(const Model &src, Model &dst);
+
+// Picks a legal action from a row of policy logits. Illegal actions are masked
+// out; a temperature of 0 selects the most likely legal action.
+Action sample_action(const Tensor &logits, const Board &board,
+                     double temperature, std::mt19937 &rng);
+
+} // namespace double_go
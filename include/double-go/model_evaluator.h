@@ -0,0 +1,27 @@
+#pragma once
+
+#include "model.h"
+#include "search.h"
+
+#include <deque>
+#include <memory>
+
+namespace double_go {
+
+// Search leaf evaluation by the network: softmax of the policy head and the
+// value head, one position per forward pass. The model may be shared
+// between evaluators on different threads as long as it stays in eval mode.
+class ModelEvaluator : public Evaluator {
+public:
+  explicit ModelEvaluator(std::shared_ptr<Model> model);
+
+  Evaluation evaluate(const std::deque<Board> &history) override;
+
+  // Evaluates with model from now on, e.g. freshly published weights.
+  void set_model(std::shared_ptr<Model> model) { model_ = std::move(model); }
+
+private:
+  std::shared_ptr<Model> model_;
+};
+
+} // namespace double_go
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "board.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace double_go {
+
+// 3x3 neighbourhood of a point, 2 bits per neighbour: 0 empty, 1 black,
+// 2 white, 3 off the board. Neighbours are ordered N, E, S, W, NE, SE, SW,
+// NW from the low bits up.
+using PatternCode = uint16_t;
+
+constexpr int PATTERN_COUNT = 1 << 16;
+
+// True if a stone of the given color on a point with this neighbourhood
+// would fill its own eye: every orthogonal neighbour is that color (or off
+// the board) and the opponent holds fewer than two diagonals, or none on
+// the edge. Looked up in a table built once.
+bool is_eye_pattern(PatternCode code, Color color);
+
+// Pattern code with black and white swapped, so one weight table can
+// serve both colors.
+PatternCode swap_colors(PatternCode code);
+
+// A Board plus per-point features kept up to date as moves are applied:
+// the 3x3 pattern code of every point and which points are the last
+// liberty of a group. Updates touch only the neighbourhood of the stones
+// that changed, so a playout policy can rescore just dirty() after each
+// move instead of the whole board.
+class PatternBoard {
+public:
+  explicit PatternBoard(const Board &board);
+
+  const Board &board() const { return board_; }
+  int size() const { return size_; }
+
+  // Applies the action to the underlying board. Returns false, changing
+  // nothing, if the board rejects it.
+  bool apply(Action a);
+
+  PatternCode pattern(int idx) const { return codes_[idx]; }
+  bool is_eye(int idx, Color color) const {
+    return is_eye_pattern(codes_[idx], color);
+  }
+
+  // Playing here captures an opponent group in atari.
+  bool captures(int idx, Color mover) const {
+    return atari_[idx] & atari_bit(opponent(mover));
+  }
+  // Playing here extends one of the mover's groups in atari.
+  bool extends_atari(int idx, Color mover) const {
+    return atari_[idx] & atari_bit(mover);
+  }
+  // Playing here leaves the new stone's group with a single liberty and
+  // captures nothing. Computed on demand; most points are rejected after
+  // looking at their pattern.
+  bool is_self_atari(int idx, Color mover) const;
+
+  // Points whose features may have changed in the last apply(): the
+  // neighbourhoods of the stones placed and removed, and the liberties of
+  // every group touching them.
+  const std::vector<int> &dirty() const { return dirty_; }
+
+private:
+  struct AtariGroup {
+    int stone; // any stone of the group
+    int liberty;
+    Color color;
+  };
+
+  static uint8_t atari_bit(Color c) { return c == Color::Black ? 1 : 2; }
+  PatternCode compute_code(int idx) const;
+  void mark_dirty(int idx);
+  // Recounts the liberties of the groups containing the given stones and
+  // refreshes the atari records and flags of any group touched.
+  void update_atari(const std::vector<int> &stones);
+
+  Board board_;
+  int size_;
+  std::vector<Color> grid_;
+  std::vector<PatternCode> codes_;
+  std::vector<uint8_t> atari_;
+  std::vector<AtariGroup> atari_groups_;
+  std::vector<int> dirty_;
+  std::vector<int> changed_;
+  std::vector<int> stones_;
+  std::vector<int> touched_;
+  // Per-point stamps, so floods and dirty marking need no clearing. Every
+  // flood or update takes a fresh value of stamp_.
+  mutable std::vector<int> stack_;
+  mutable std::vector<uint32_t> group_stamp_;
+  mutable std::vector<uint32_t> liberty_stamp_;
+  std::vector<uint32_t> dirty_stamp_;
+  mutable uint32_t stamp_ = 0;
+  uint32_t dirty_round_ = 0;
+};
+
+} // namespace double_go
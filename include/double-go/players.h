@@ -0,0 +1,26 @@
+#pragma once
+
+#include "match.h"
+#include "search.h"
+
+#include <string>
+
+namespace double_go {
+
+// The Torch-free players by name, for the tools that let users pick bots:
+//
+//   random              uniform over legal actions
+//   rollout             the rollout policy with default weights
+//   rollout:FILE        the rollout policy with weights from FILE
+//   mcts, mcts:FILE     search with rollout evaluations, configured by search
+//   gumbel, gumbel:FILE the same with RootPolicy::Gumbel
+//
+// Search players take their komi from the game rather than from search, and
+// report their progress to observer, if given, from the thread they are asked
+// to move on. Returns an empty factory for unknown
+// names. Throws std::runtime_error if a weights file cannot be loaded.
+PlayerFactory make_player_factory(const std::string &name,
+                                  const SearchConfig &search = {},
+                                  SearchObserver observer = nullptr);
+
+} // namespace double_go
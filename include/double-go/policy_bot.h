@@ -0,0 +1,25 @@
+#pragma once
+
+#include "model.h"
+
+#include <deque>
+#include <memory>
+#include <random>
+
+namespace double_go {
+
+// Plays straight from the policy head, without search. The model may be
+// shared between bots on different threads as long as it stays in eval mode.
+class PolicyBot {
+public:
+  explicit PolicyBot(std::shared_ptr<Model> model, double temperature = 0.0,
+                     unsigned seed = std::random_device{}());
+  Action pick_action(const std::deque<Board> &history);
+
+private:
+  std::shared_ptr<Model> model_;
+  double temperature_;
+  std::mt19937 rng_;
+};
+
+} // namespace double_go
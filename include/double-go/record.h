@@ -0,0 +1,58 @@
+#pragma once
+
+#include "board.h"
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace double_go {
+
+// A game as the actions played from the empty board, plus a copy of the
+// position every keyframe_interval actions. position(n) starts from the
+// nearest keyframe at or before n, so seeking anywhere costs fewer than
+// keyframe_interval applies however long the game is. Keyframes are built
+// as actions are added and cost one Board each.
+class GameRecord {
+public:
+  explicit GameRecord(int board_size = 19, double komi = 6.5,
+                      int keyframe_interval = 32);
+
+  int board_size() const { return board_size_; }
+  double komi() const { return komi_; }
+  int keyframe_interval() const { return interval_; }
+  const std::vector<Action> &actions() const { return actions_; }
+  int num_moves() const { return static_cast<int>(actions_.size()); }
+
+  // Appends an action played in the final position. Returns false, changing
+  // nothing, if it is illegal there or the game is over.
+  bool add(Action a);
+
+  // The position after the first move actions, 0 <= move <= num_moves().
+  Board position(int move) const;
+  const Board &final_position() const { return last_; }
+
+private:
+  int board_size_;
+  double komi_;
+  int interval_;
+  std::vector<Action> actions_;
+  std::vector<Board> keyframes_; // keyframes_[k]: after k * interval_ actions
+  Board last_;
+};
+
+// Record files hold one game per line: board size, komi, then the action
+// indices (see action_index). Blank lines and lines starting with '#' are
+// skipped. Only actions are stored; keyframes are rebuilt on loading.
+void write_record(std::ostream &out, const GameRecord &record);
+
+// Throws std::runtime_error on I/O failure, a malformed line or an illegal
+// action.
+std::vector<GameRecord> read_records(std::istream &in,
+                                     const std::string &name = "records");
+std::vector<GameRecord> load_records(const std::string &path);
+void save_records(const std::string &path,
+                  const std::vector<GameRecord> &records);
+
+} // namespace double_go
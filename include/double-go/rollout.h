@@ -0,0 +1,92 @@
+#pragma once
+
+#include "patterns.h"
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace double_go {
+
+// Non-negative weights over n slots, sampled in proportion to their values.
+// set() and find() are O(log n) on a Fenwick tree, so a playout only pays
+// for the points a move actually changed.
+class FenwickSampler {
+public:
+  explicit FenwickSampler(int n = 0);
+
+  // Resizes to n slots, all zero.
+  void reset(int n);
+  void set(int i, double weight);
+  double weight(int i) const { return weights_[i]; }
+  double total() const { return total_; }
+  // The slot whose cumulative range contains u, for u in [0, total()).
+  // Falls back to a linear scan when rounding in the tree leaves u past the
+  // last non-zero slot; returns -1 only if every weight is zero.
+  int find(double u) const;
+
+private:
+  std::vector<double> tree_; // 1-based partial sums
+  std::vector<double> weights_;
+  double total_ = 0.0;
+  int top_bit_ = 0;
+};
+
+// Log-linear weights of the rollout policy. A candidate point's weight is
+// exp(pattern[code] + the tactical weights that apply), where code is the
+// point's 3x3 pattern seen by the mover (White's are color-swapped first).
+// Filling one's own eye is never a candidate.
+struct RolloutWeights {
+  std::vector<float> pattern = std::vector<float>(PATTERN_COUNT, 0.0f);
+  float capture = 0.0f;
+  float extend_atari = 0.0f;
+  float self_atari = 0.0f;
+
+  // Hand-set starting point: favour captures and saving groups in atari,
+  // avoid self-atari, and leave patterns neutral.
+  static RolloutWeights defaults();
+
+  float log_weight(const PatternBoard &pb, int idx, Color mover) const;
+
+  // One SGD step on the negative log-likelihood of the played placement
+  // under the softmax over all candidates. Returns the loss, or nothing if
+  // the move is not a candidate (an eye fill, or the only legal move).
+  std::optional<double> train_step(const Board &board, Point played,
+                                   double learning_rate);
+
+  // Throws std::runtime_error on I/O failure or a malformed file.
+  void save(const std::string &path) const;
+  static RolloutWeights load(const std::string &path);
+};
+
+// Samples moves from the softmax rollout policy. Passes only when no
+// candidate is legal.
+class RolloutBot {
+public:
+  explicit RolloutBot(std::shared_ptr<const RolloutWeights> weights = nullptr,
+                      unsigned seed = std::random_device{}());
+
+  Action pick_action(const Board &board);
+
+  // Plays the game out from board for at most max_moves actions and returns
+  // the final position. Features and sampler weights are updated
+  // incrementally from PatternBoard::dirty(). Any superko history is rolled
+  // back before returning.
+  Board playout(const Board &board, int max_moves);
+
+private:
+  // Refreshes the sampler weights of both colors at idx.
+  void rescore(const PatternBoard &pb, int idx);
+  // Draws a legal candidate for the side to move, or a pass.
+  Action sample(const PatternBoard &pb, FenwickSampler &sampler);
+
+  std::shared_ptr<const RolloutWeights> weights_;
+  std::mt19937 rng_;
+  std::array<FenwickSampler, 2> samplers_; // Black, White
+  std::vector<int> rejected_;
+};
+
+} // namespace double_go
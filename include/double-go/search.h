@@ -0,0 +1,360 @@
+#pragma once
+
+#include "board.h"
+#include "rollout.h"
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace double_go {
+
+// ── Evaluation ──────────────────────────────────────────────────────────────
+
+struct Evaluation {
+  // Prior over action indices (see action_index), size * size + 1 entries.
+  // Need not be normalized or masked: search keeps the legal actions and
+  // renormalizes.
+  std::vector<float> policy;
+  // Expected outcome for the side to move in the evaluated position, in
+  // [-1, 1].
+  float value = 0.0f;
+};
+
+// Prior and value for a leaf of the search. history.back() is the position
+// to evaluate and the boards before it, oldest first, led to it.
+class Evaluator {
+public:
+  virtual ~Evaluator() = default;
+  virtual Evaluation evaluate(const std::deque<Board> &history) = 0;
+};
+
+// Torch-free evaluator: priors are the rollout policy's softmax over the
+// candidate points (pass weighs as much as a neutral pattern, eye fills get
+// nothing), and the value is the result of one rollout playout.
+class RolloutEvaluator : public Evaluator {
+public:
+  explicit RolloutEvaluator(
+      std::shared_ptr<const RolloutWeights> weights = nullptr,
+      double komi = 6.5, unsigned seed = std::random_device{}());
+
+  Evaluation evaluate(const std::deque<Board> &history) override;
+
+private:
+  std::shared_ptr<const RolloutWeights> weights_;
+  RolloutBot bot_;
+  double komi_;
+};
+
+// ── Tree storage ────────────────────────────────────────────────────────────
+
+// IEEE half precision, round to nearest even. Priors are stored this way:
+// 11 significant bits are plenty for PUCT and halve the prior's footprint.
+uint16_t float_to_half(float f);
+float half_to_float(uint16_t h);
+
+// Search tree in two arenas. A node owns one contiguous array of edges, and
+// nodes and edges refer to each other by 32-bit index rather than pointer.
+// A child node is only materialized the first time its edge is followed, so
+// an expanded node costs its edge array plus one node per child searched.
+// clear() keeps the memory for the next search.
+class SearchTree {
+public:
+  static constexpr uint16_t NO_ACTION = 0xFFFF;
+  static constexpr uint32_t NO_NODE = 0; // the root is never a child
+
+  struct Edge {
+    uint16_t first;  // action index
+    uint16_t second; // second stone of a macro-action, or NO_ACTION
+    uint16_t prior;  // half precision
+    uint16_t unused = 0;
+    uint32_t visits = 0;
+    float q = 0.0f; // mean value for the player choosing this edge
+    uint32_t child = NO_NODE;
+  };
+  struct Node {
+    uint32_t first_edge = 0;
+    uint32_t visits = 0;
+    float value = 0.0f; // evaluation for the side to move here
+    uint16_t num_edges = 0; // 0 until expanded
+  };
+  static_assert(sizeof(Edge) == 20);
+  static_assert(sizeof(Node) == 16);
+
+  // Edge arrays never straddle a chunk, which bounds a node's edge count.
+  static constexpr int CHUNK_BITS = 16;
+  static constexpr uint32_t MAX_EDGES = 1u << CHUNK_BITS;
+
+  SearchTree();
+
+  // Leaves only an unexpanded root, node 0.
+  void clear();
+
+  Node &node(uint32_t i) { return node_chunk(i)[i & CHUNK_MASK]; }
+  Edge &edge(uint32_t i) { return edge_chunk(i)[i & CHUNK_MASK]; }
+  uint32_t add_node();
+  // Allocates the node's edge array. Throws std::length_error unless
+  // 0 < count < MAX_EDGES.
+  void allocate_edges(uint32_t node, uint32_t count);
+  // The child of edge i, materialized on first use.
+  uint32_t child(uint32_t edge);
+
+  size_t num_nodes() const { return num_nodes_; }
+  size_t num_edges() const { return num_edges_; }
+  // Bytes in use by nodes and their edge arrays; reserved capacity is not
+  // counted.
+  size_t bytes() const {
+    return num_nodes_ * sizeof(Node) + num_edges_ * sizeof(Edge);
+  }
+
+private:
+  static constexpr uint32_t CHUNK_MASK = MAX_EDGES - 1;
+
+  Node *node_chunk(uint32_t i) { return nodes_[i >> CHUNK_BITS].get(); }
+  Edge *edge_chunk(uint32_t i) { return edges_[i >> CHUNK_BITS].get(); }
+
+  std::vector<std::unique_ptr<Node[]>> nodes_;
+  std::vector<std::unique_ptr<Edge[]>> edges_;
+  uint32_t next_node_ = 0;
+  uint32_t next_edge_ = 0; // may skip a chunk's tail
+  size_t num_nodes_ = 0;
+  size_t num_edges_ = 0;
+};
+
+// ── Monte Carlo tree search ─────────────────────────────────────────────────
+
+// How Search spends its visits at the root; below it, always PUCT.
+enum class RootPolicy { Puct, Gumbel };
+
+struct SearchConfig {
+  int visits = 200;
+  float c_puct = 1.5f;
+  double komi = 6.5;
+
+  // Search a whole two-stone turn as one macro-action instead of two plies.
+  // The N^2 pairs are never enumerated: a First-phase node keeps only the
+  // macro_first most likely first stones and, for each, the macro_second
+  // most likely replies (including passing the second stone), with the
+  // factorized prior P(a) * P(b | a). Both factors come from the single
+  // evaluation of the node, P(b | a) being P(b) renormalized over the
+  // replies kept, so each first stone keeps its own prior mass. Pairs
+  // reaching the same position are merged. macro_first * macro_second must
+  // stay below SearchTree::MAX_EDGES.
+  bool macro_actions = false;
+  int macro_first = 8;
+  int macro_second = 8;
+
+  // Spend the visits only where they can change the most visited root
+  // edge, which is the one played. Root edges that could not catch the
+  // leader even with every visit left are no longer selected, and the
+  // search stops once no edge can. The root's visit counts are then not
+  // those of a full search.
+  bool early_stop = false;
+
+  // With RootPolicy::Gumbel the root samples gumbel_considered edges
+  // without replacement, by Gumbel noise added to the log priors, and
+  // divides the visits between them by sequential halving: each round
+  // gives the candidates left equal visits, then keeps the better half by
+  // noise, log prior and sigma(q). The last one standing is the move to
+  // play. At a few dozen visits this plays and trains far better than
+  // PUCT, whose visit counts are then mostly prior. early_stop does not
+  // apply.
+  RootPolicy root_policy = RootPolicy::Puct;
+  int gumbel_considered = 16;
+  bool gumbel_noise = true; // without it, the top priors are considered
+  // sigma(q) = (c_visit + most visits on a root edge) * c_scale * q, with q
+  // mapped from [-1, 1] to [0, 1].
+  float c_visit = 50.0f;
+  float c_scale = 1.0f;
+  unsigned seed = 0; // for the noise; 0: nondeterministic
+};
+
+// Statistics of one root edge. second is set for macro-actions.
+struct SearchChild {
+  Action first;
+  std::optional<Action> second;
+  float prior = 0.0f;
+  int visits = 0;
+  // Mean value for the side to move at the root.
+  float q = 0.0f;
+  // Improved policy: softmax of log prior + sigma(q), an unvisited edge's q
+  // taken from the search's value estimate. Sums to 1 over the children;
+  // the policy target for training.
+  float improved = 0.0f;
+};
+
+struct SearchResult {
+  // Root edges, the move to play first (the most visited, or the Gumbel
+  // survivor), then most visited first.
+  std::vector<SearchChild> children;
+  // Mean value of the search for the side to move at the root.
+  float value = 0.0f;
+  int visits = 0;
+  // Principal variation: the move to play, then the most visited edges
+  // down the tree, both stones of a macro-action included.
+  std::vector<Action> pv;
+  // Simulations of config().visits that early_stop found unnecessary.
+  int saved_visits = 0;
+  // Size of the tree the search built.
+  size_t tree_nodes = 0;
+  size_t tree_edges = 0;
+  size_t tree_bytes = 0;
+};
+
+// Receives the search so far, on the thread running the search.
+using SearchObserver = std::function<void(const SearchResult &)>;
+
+// The race between the root's edges, cheap enough to take after every
+// simulation.
+struct SearchProgress {
+  int visits = 0;   // simulations so far
+  int children = 0; // root edges
+  int best = -1;    // most visited root edge, in the root's edge order
+  int best_visits = 0;
+  int second_visits = 0;
+  // Mean value of the best edge for the side to move at the root.
+  float best_q = 0.0f;
+};
+
+// Asked after every simulation whether to stop the search.
+using SearchStopCheck = std::function<bool(const SearchProgress &)>;
+
+using SearchDeadline = std::chrono::steady_clock::time_point;
+
+// PUCT search over Double Go positions. The side to move does not simply
+// alternate (a turn is one or two stones, plus a bonus stone after the
+// opponent's double), so every edge stores its value from the perspective
+// of the player who chose it, and a leaf's value is negated only on the
+// edges chosen by the other side.
+//
+// The tree holds actions, not boards: each simulation replays its path on a
+// copy of the root. Each run starts from an empty tree; only the capacity of
+// the node and edge arenas is kept from one run to the next.
+// Superko history shared with the root board is marked before and rolled
+// back after every simulation.
+class Search {
+public:
+  explicit Search(std::shared_ptr<Evaluator> evaluator,
+                  SearchConfig config = {});
+
+  const SearchConfig &config() const { return config_; }
+
+  // Searches the position history.back(). history must not be empty.
+  // With a deadline, stops early once it passes, though never before the
+  // root is expanded.
+  SearchResult run(const std::deque<Board> &history,
+                   std::optional<SearchDeadline> deadline = std::nullopt);
+
+  // While run() is searching, calls observer with the result so far at most
+  // once per interval, and always with the final result. Collecting a
+  // result walks the root's edges, so a short interval slows the search.
+  void set_observer(SearchObserver observer,
+                    std::chrono::milliseconds interval =
+                        std::chrono::milliseconds(100)) {
+    observer_ = std::move(observer);
+    observer_interval_ = interval;
+  }
+
+  // While run() is searching, stops it as soon as check returns true. The
+  // root is always expanded first.
+  void set_stop_check(SearchStopCheck check) {
+    stop_check_ = std::move(check);
+  }
+
+private:
+  // Root-to-leaf path: edge indices and the player who chose each.
+  struct Step {
+    uint32_t edge;
+    Color chooser;
+  };
+  // An edge about to be allocated, while priors are still being merged and
+  // normalized.
+  struct PendingEdge {
+    uint16_t first;
+    uint16_t second;
+    float prior;
+  };
+  // A root edge considered by the Gumbel root policy, with its Gumbel
+  // noise plus log prior.
+  struct Candidate {
+    uint32_t edge;
+    float score;
+  };
+
+  // The edge to follow from node, among those with at least min_visits
+  // visits. One edge at least must qualify.
+  uint32_t select(uint32_t node, uint32_t min_visits = 0);
+  // Evaluates history.back() and adds the node's edges. Returns the value
+  // for the side to move.
+  float expand(uint32_t node, const std::deque<Board> &history);
+  void add_edges(const Board &board, const std::vector<float> &policy);
+  void add_macro_edges(const Board &board, const std::vector<float> &policy);
+  float terminal_value(const Board &board) const;
+  SearchResult collect(int size);
+  SearchProgress progress();
+
+  // Gumbel root policy. start_gumbel samples the candidates of an expanded
+  // root given the root visits to spend.
+  void start_gumbel(int visits);
+  uint32_t select_gumbel();
+  // Orders the first count candidates best first.
+  void rank_candidates(size_t count);
+  float sigma(float q, uint32_t max_visits) const;
+  // The root's value with unvisited edges' values filled in from the
+  // visited ones, weighted by prior.
+  float mixed_value();
+
+  std::shared_ptr<Evaluator> evaluator_;
+  SearchConfig config_;
+  SearchObserver observer_;
+  std::chrono::milliseconds observer_interval_{100};
+  SearchStopCheck stop_check_;
+  SearchTree tree_;
+  std::vector<Step> path_;
+  std::vector<PendingEdge> pending_;
+  std::mt19937 rng_;
+  std::vector<Candidate> candidates_;
+  size_t considered_ = 0; // candidates still in the running, at the front
+  uint32_t phase_visits_ = 0; // visits each should have by the round's end
+  int gumbel_visits_ = 0;
+  int gumbel_rounds_ = 0;
+  int chosen_ = -1; // root edge to play when the Gumbel policy picked one
+};
+
+// Plays the search's move, the first of SearchResult::children. With
+// macro-actions on, the second stone of the chosen pair is remembered and
+// played on the next call if the position is the one the pair was planned
+// for.
+class MctsBot {
+public:
+  explicit MctsBot(std::shared_ptr<Evaluator> evaluator,
+                   SearchConfig config = {});
+
+  // Searches until config().visits or the deadline, whichever comes first.
+  Action pick_action(const std::deque<Board> &history,
+                     std::optional<SearchDeadline> deadline = std::nullopt);
+
+  // See Search::set_observer. Planned second stones are played without
+  // searching, so they are not observed.
+  void set_observer(SearchObserver observer,
+                    std::chrono::milliseconds interval =
+                        std::chrono::milliseconds(100)) {
+    search_.set_observer(std::move(observer), interval);
+  }
+  // See Search::set_stop_check.
+  void set_stop_check(SearchStopCheck check) {
+    search_.set_stop_check(std::move(check));
+  }
+
+private:
+  Search search_;
+  std::optional<Action> planned_;
+  uint64_t planned_hash_ = 0;
+};
+
+} // namespace double_go
@@ -0,0 +1,214 @@
+#pragma once
+
+#include "model.h"
+#include "record.h"
+#include "search.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace double_go {
+
+// Double-buffered weights shared between the trainer and self-play workers.
+// Workers lease the active buffer for one batched forward pass or one
+// search; the trainer writes into the inactive buffer and flips it live.
+// Workers never block, and the trainer only waits for stragglers still
+// finishing a forward pass or search on the buffer it is about to overwrite.
+// publish() must only be called from one thread.
+class ModelSlot {
+public:
+  class Lease {
+  public:
+    Lease(Lease &&other) noexcept;
+    Lease(const Lease &) = delete;
+    Lease &operator=(const Lease &) = delete;
+    Lease &operator=(Lease &&) = delete;
+    ~Lease();
+
+    Model &model() const { return *slot_->buffers_[index_]; }
+    std::shared_ptr<Model> shared_model() const {
+      return slot_->buffers_[index_];
+    }
+    uint64_t generation() const { return generation_; }
+
+  private:
+    friend class ModelSlot;
+    Lease(const ModelSlot *slot, int index, uint64_t generation)
+        : slot_(slot), index_(index), generation_(generation) {}
+
+    const ModelSlot *slot_;
+    int index_;
+    uint64_t generation_;
+  };
+
+  explicit ModelSlot(const Model &initial);
+
+  Lease acquire() const;
+  void publish(const Model &source);
+  uint64_t generation() const { return generation_.load(); }
+
+private:
+  std::array<std::shared_ptr<Model>, 2> buffers_;
+  std::array<uint64_t, 2> buffer_generation_{0, 0};
+  mutable std::array<std::atomic<int>, 2> readers_{};
+  std::atomic<int> active_{0};
+  std::atomic<uint64_t> generation_{0};
+};
+
+struct TrainingSample {
+  Tensor encoding; // [NUM_PLANES, size, size]
+  Tensor policy;   // [size * size + 1] target distribution
+  float value;     // game outcome from the perspective of the side to move
+};
+
+// The policy target of a searched position: each root child's improved
+// policy at its action index (see action_index), zero elsewhere.
+Tensor improved_policy_target(const SearchResult &result, int board_size);
+
+// Fixed-capacity ring buffer of training samples, written by self-play
+// workers and sampled by the trainer.
+class ReplayBuffer {
+public:
+  explicit ReplayBuffer(size_t capacity);
+
+  void add(std::vector<TrainingSample> samples);
+  size_t size() const;
+  uint64_t total_added() const;
+
+  // Draws batch_size samples uniformly with replacement and stacks them into
+  // (encodings, policies, values). The buffer must not be empty.
+  std::tuple<Tensor, Tensor, Tensor> sample(size_t batch_size,
+                                            std::mt19937 &rng) const;
+
+private:
+  mutable std::mutex mutex_;
+  std::vector<TrainingSample> samples_;
+  size_t capacity_;
+  size_t next_ = 0;
+  uint64_t total_added_ = 0;
+};
+
+struct SelfPlayConfig {
+  int num_workers = 0;      // 0: one per core, minus the trainer thread
+  int games_per_batch = 16; // concurrent games per worker, one forward each
+  int max_moves = 0;        // 0: 4 * size * size placements and passes
+  double komi = 6.5;
+  double temperature = 1.0;
+  int temperature_moves = 30; // play greedily after this many moves
+
+  // With search_visits > 0, every move is searched with that many
+  // simulations over the network, by Gumbel root selection (see
+  // RootPolicy) among search_considered candidates. The search's move is
+  // played, its Gumbel noise standing in for the temperature, and its
+  // improved policy is the policy target. With 0, moves are sampled from
+  // the raw policy and the samples train the value head only: the policy
+  // target is all zeros, since training toward moves sampled from the
+  // policy itself teaches it nothing in expectation.
+  int search_visits = 32;
+  int search_considered = 16;
+  // End games once pass-alive stones and territory decide the winner,
+  // instead of playing them out.
+  bool stop_when_settled = true;
+
+  // A side resigns once the value head has rated its position below
+  // resign_threshold on resign_consecutive of its evaluations in a row.
+  // A threshold of -1 or less disables resignation.
+  double resign_threshold = -0.9;
+  int resign_consecutive = 3;
+  // Fraction of games played out with resignation disabled, to measure how
+  // often resigning would have thrown away a win.
+  double resign_disabled_fraction = 0.1;
+
+  // After adjudicate_moves moves (0: never), a game ends as soon as
+  // Board::score puts one side at least adjudicate_margin points ahead.
+  int adjudicate_moves = 0;
+  double adjudicate_margin = 20.0;
+
+  // If set, every finished game is written to this record file (see
+  // record.h), for replaying in the GUI.
+  std::string record_path;
+};
+
+struct TrainerConfig {
+  int batch_size = 256;
+  double learning_rate = 0.01;
+  double momentum = 0.9;
+  double weight_decay = 1e-4;
+  int steps_per_generation = 500;
+  size_t min_samples = 4096; // trainer idles until the buffer holds this many
+  size_t buffer_capacity = 500000;
+  int intra_op_threads = 1;
+};
+
+struct PipelineStats {
+  uint64_t generation = 0;
+  uint64_t games = 0;
+  uint64_t samples = 0;
+  double loss = 0.0; // mean over the last generation
+  uint64_t resigned = 0;
+  uint64_t adjudicated = 0;
+  // Games played with resignation disabled in which a side crossed the
+  // threshold, and how many of those that side went on to win.
+  uint64_t resign_checked = 0;
+  uint64_t resign_false_positives = 0;
+
+  double resign_false_positive_rate() const {
+    return resign_checked ? double(resign_false_positives) / resign_checked
+                          : 0.0;
+  }
+};
+
+// Runs self-play workers and the trainer concurrently. Workers pick up newly
+// published weights between batches, so there is no stop-the-world reload
+// between generations.
+class Pipeline {
+public:
+  using GenerationCallback =
+      std::function<void(const PipelineStats &, const Model &)>;
+
+  Pipeline(std::shared_ptr<Model> model, SelfPlayConfig self_play,
+           TrainerConfig trainer);
+  ~Pipeline();
+
+  // Trains for the given number of generations on the calling thread while
+  // the workers play in the background. on_generation is invoked after each
+  // publish with the freshly trained model.
+  void run(int generations, const GenerationCallback &on_generation = {});
+
+  PipelineStats stats() const;
+  const ReplayBuffer &buffer() const { return buffer_; }
+
+private:
+  void start_workers();
+  void stop_workers();
+  void worker_loop(int worker_id);
+  double train_step(torch::optim::Optimizer &optimizer, std::mt19937 &rng);
+
+  std::shared_ptr<Model> model_;
+  SelfPlayConfig self_play_;
+  TrainerConfig trainer_;
+  ModelSlot slot_;
+  ReplayBuffer buffer_;
+  std::vector<std::thread> workers_;
+  std::atomic<bool> stop_{false};
+  std::atomic<uint64_t> games_{0};
+  std::atomic<uint64_t> resigned_{0};
+  std::atomic<uint64_t> adjudicated_{0};
+  std::atomic<uint64_t> resign_checked_{0};
+  std::atomic<uint64_t> resign_false_positives_{0};
+  double last_loss_ = 0.0;
+  std::mutex record_mutex_;
+  std::ofstream records_;
+};
+
+} // namespace double_go
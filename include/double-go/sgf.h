@@ -0,0 +1,88 @@
+#pragma once
+
+#include "board.h"
+#include "record.h"
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace double_go {
+
+// SGF for Double Go. Every stone is its own node, B[] or W[] with an empty
+// value for a pass, and carries the Double Go property PH naming the phase
+// it was played in: PH[1] first stone, PH[2] second stone, PH[b] bonus
+// stone. Phases follow from the moves, so PH is checked rather than needed
+// when reading. Root properties used: SZ, KM and RE.
+//
+//   (;GM[1]FF[4]CA[UTF-8]AP[double-go]SZ[9]KM[6.5]RE[B+3.5]
+//   ;B[cc]PH[1];B[gg]PH[2];W[cg]PH[b];W[gc]PH[1];W[ee]PH[2]...)
+
+// One game's main line.
+struct SgfGame {
+  int board_size = 19;
+  double komi = 6.5;
+  std::string result; // RE, empty if absent
+  std::vector<Action> actions;
+};
+
+// Reads game trees one at a time from a stream, following the first
+// variation of each. Storage is reused from one game to the next, so a
+// large collection is parsed without allocating per node. Every move is
+// played on a Board and must be legal and made by the side to move, in the
+// phase given by PH if present. Setup stones (AB, AW, AE) are rejected,
+// since replaying without them would give a different game; other unknown
+// properties are skipped.
+class SgfReader {
+public:
+  explicit SgfReader(std::istream &in, std::string name = "sgf");
+
+  // Reads the next game into game. Returns false at the end of the input.
+  // Throws std::runtime_error, naming the line, on malformed input or an
+  // illegal move.
+  bool next(SgfGame &game);
+
+private:
+  int peek();
+  int get();
+  int skip_space();
+  void expect(char c);
+  [[noreturn]] void fail(const std::string &what) const;
+  void read_tree(SgfGame &game);
+  void skip_tree();
+  void read_node(SgfGame &game);
+  void read_value(std::string &value);
+
+  std::streambuf *buf_;
+  std::string name_;
+  int line_ = 1;
+  Board board_;
+  bool started_ = false; // a move has been read in the current game
+  std::string ident_;
+  std::string value_;
+};
+
+// Writes games as SGF, one tree per game.
+class SgfWriter {
+public:
+  explicit SgfWriter(std::ostream &out) : out_(out) {}
+
+  // Throws std::runtime_error if an action is illegal.
+  void write(const SgfGame &game);
+  // RE is filled in from the final position if the game is over.
+  void write(const GameRecord &record);
+
+private:
+  void write(int board_size, double komi, const std::string &result,
+             const std::vector<Action> &actions);
+
+  std::ostream &out_;
+  std::string text_; // the tree being written, flushed once per game
+};
+
+// GameRecord conversions, for the viewer. Throw as SgfReader does.
+GameRecord make_record(const SgfGame &game);
+std::vector<GameRecord> load_sgf(const std::string &path);
+
+} // namespace double_go
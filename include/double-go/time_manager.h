@@ -0,0 +1,106 @@
+#pragma once
+
+#include "board.h"
+#include "search.h"
+
+#include <optional>
+
+namespace double_go {
+
+// A game clock as GTP time_settings gives it: main time, then byo-yomi
+// periods of byo_yomi_time seconds for byo_yomi_stones stones. No byo-yomi
+// stones means absolute time, and no main time either means no limit.
+struct TimeControl {
+  double main_time = 0.0;
+  double byo_yomi_time = 0.0;
+  int byo_yomi_stones = 0;
+
+  bool unlimited() const { return main_time <= 0 && byo_yomi_stones <= 0; }
+};
+
+// One player's clock as GTP time_left reports it: seconds left of main time
+// when stones is 0, else seconds left for the next stones stones of the
+// current byo-yomi period.
+struct ClockState {
+  double seconds = 0.0;
+  int stones = 0;
+};
+
+// The clock at the start of the game.
+ClockState initial_clock(const TimeControl &tc);
+// The clock after a stone that took the given seconds. Running out of main
+// time starts a byo-yomi period, and playing a period's last stone starts
+// the next. Approximate; controllers send time_left to correct it.
+ClockState charge(ClockState clock, const TimeControl &tc, double seconds);
+
+struct TimeConfig {
+  // Relative thinking time for each phase. The first stone shapes the turn
+  // and the second mostly answers it (with macro-action search it is often
+  // already planned). A bonus stone opens a three-stone turn.
+  double first_weight = 1.0;
+  double second_weight = 0.6;
+  double bonus_weight = 0.8;
+  // Own stones expected in the rest of the game, per empty point, and at
+  // least min_stones_to_go.
+  double stones_per_empty = 0.4;
+  int min_stones_to_go = 20;
+  // Seconds held back per stone for communication and process latency.
+  double overhead = 0.1;
+  // An unstable search may run to max_extension times its target. In main
+  // time no stone gets more than max_share of what is left.
+  double max_extension = 2.5;
+  double max_share = 0.2;
+  // A fall of the best edge's value over the second half of the target
+  // that counts as unstable.
+  float value_drop = 0.05f;
+};
+
+// Seconds to think about one stone: target normally, up to maximum when
+// the search has not settled.
+struct TimeBudget {
+  double target = 0.0;
+  double maximum = 0.0;
+};
+
+// Splits a clock between stones and decides, as a search runs, when to
+// stop it. A turn's time is split between its stones by phase weight.
+// The search stops at the target unless, over the second half of the
+// target, the best root edge changed or its value fell, in which case it
+// may run on to the maximum. It stops before the target once the leading
+// edge's visit lead is more than the search can do in the time left.
+class TimeManager {
+public:
+  enum class Stop { None, Target, Maximum, Decided };
+
+  explicit TimeManager(TimeConfig config = {});
+
+  const TimeConfig &config() const { return config_; }
+
+  // The budget for the stone to play in board. Zero if tc is unlimited.
+  TimeBudget allocate(const Board &board, const TimeControl &tc,
+                      ClockState clock) const;
+
+  // Begins timing one search.
+  void start(TimeBudget budget);
+  // Whether to stop the search started last, given its progress after
+  // elapsed seconds. Meant for Search::set_stop_check.
+  bool should_stop(const SearchProgress &progress, double elapsed);
+
+  // Why the last search stopped; None if the stop check never asked.
+  Stop last_stop() const { return stop_; }
+  // Whether the last search ran past its target.
+  bool extended() const { return extended_; }
+
+private:
+  double weight(Phase phase) const;
+
+  TimeConfig config_;
+  TimeBudget budget_;
+  int best_ = -1;
+  double changed_at_ = 0.0; // elapsed seconds when best_ last changed
+  std::optional<float> mid_q_; // best edge's value at half the target
+  bool extended_ = false;
+  Stop stop_ = Stop::None;
+};
+
+} // namespace double_go
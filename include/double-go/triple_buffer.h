@@ -0,0 +1,47 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace double_go {
+
+// Lock-free handoff of the latest value from one writer thread to one
+// reader thread. Each side owns one of three slots; the third sits in the
+// middle. The writer fills its slot and publishes it by swapping it with the
+// middle one, and the reader takes the middle slot in exchange for its own
+// when something new is there. Neither side ever waits. The reader always
+// gets the newest complete value, skipping any it was too slow to see.
+template <typename T> class TripleBuffer {
+public:
+  // Writer side: fill write_slot(), then publish() it. The slot handed back
+  // holds an older value whose storage can be reused.
+  T &write_slot() { return slots_[back_]; }
+  void publish() {
+    uint8_t old = middle_.exchange(back_ | FRESH, std::memory_order_acq_rel);
+    back_ = old & INDEX;
+  }
+
+  // Reader side: update() moves the newest published value into
+  // read_slot() and returns true, or returns false if nothing was
+  // published since the last update.
+  bool update() {
+    if (!(middle_.load(std::memory_order_relaxed) & FRESH))
+      return false;
+    uint8_t old = middle_.exchange(front_, std::memory_order_acq_rel);
+    front_ = old & INDEX;
+    return true;
+  }
+  const T &read_slot() const { return slots_[front_]; }
+
+private:
+  static constexpr uint8_t INDEX = 3;
+  static constexpr uint8_t FRESH = 4;
+
+  std::array<T, 3> slots_{};
+  uint8_t back_ = 0;  // writer's slot
+  uint8_t front_ = 1; // reader's slot
+  alignas(64) std::atomic<uint8_t> middle_{2};
+};
+
+} // namespace double_go
@@ -31,4 +31,18 @@ struct Action {
   bool operator==(const Action &) const = default;
 };
 
+// Flat index of an action on a board of the given size, matching the policy
+// head layout: points in row-major order, then pass at size * size.
+inline int action_index(Action a, int size) {
+  if (a.type == ActionType::Pass)
+    return size * size;
+  return a.point.row * size + a.point.col;
+}
+
+inline Action index_action(int idx, int size) {
+  if (idx == size * size)
+    return Action::pass();
+  return Action::place({idx / size, idx % size});
+}
+
 } // namespace double_go
@@ -0,0 +1,199 @@
+#include "double-go/checkpoint.h"
+#include "double-go/double-go.h"
+#include "double-go/match.h"
+#include "double-go/model_evaluator.h"
+#include "double-go/players.h"
+#include "double-go/policy_bot.h"
+#include "double-go/search.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+void usage(const char *prog) {
+  std::fprintf(stderr,
+               "usage: %s --a PLAYER --b PLAYER [--games N] [--threads N]\n"
+               "          [--komi X[,X...]] [--temperature X]\n"
+               "          [--sprt ELO0,ELO1] [--alpha X] [--beta X]\n"
+               "          [--visits N] [--macro] [--seed N]\n"
+               "PLAYER is a checkpoint path, 'random', 'rollout',\n"
+               "'rollout:WEIGHTS_FILE', 'mcts[:WEIGHTS_FILE]' or\n"
+               "'gumbel[:WEIGHTS_FILE]'. With --visits N > 0, checkpoints\n"
+               "search N simulations per move instead of playing from the\n"
+               "policy; --macro searches two-stone turns as one action.\n",
+               prog);
+}
+
+std::vector<double> parse_list(const char *s) {
+  std::vector<double> out;
+  std::stringstream ss(s);
+  std::string item;
+  while (std::getline(ss, item, ','))
+    out.push_back(std::atof(item.c_str()));
+  return out;
+}
+
+struct PlayerSpec {
+  double_go::PlayerFactory factory;        // the Torch-free bots
+  std::shared_ptr<double_go::Model> model; // checkpoints
+};
+
+// Built-in bots by name (see make_player_factory), anything else is loaded as
+// a checkpoint. Built-in search bots use the default visits unless --visits
+// is given.
+PlayerSpec load_player(const std::string &name,
+                       const double_go::SearchConfig &search) {
+  auto config = search;
+  if (config.visits <= 0)
+    config.visits = double_go::SearchConfig{}.visits;
+  if (auto factory = double_go::make_player_factory(name, config))
+    return {std::move(factory), nullptr};
+  return {nullptr, double_go::load_checkpoint(name)};
+}
+
+double_go::PlayerFactory make_factory(const PlayerSpec &spec,
+                                      double temperature,
+                                      const double_go::SearchConfig &search) {
+  if (spec.factory)
+    return spec.factory;
+  auto model = spec.model;
+  if (search.visits > 0) {
+    return [model, search](unsigned seed, double komi) -> double_go::Player {
+      auto evaluator = std::make_shared<double_go::ModelEvaluator>(model);
+      auto game = search;
+      game.seed = seed;
+      game.komi = komi;
+      auto bot = std::make_shared<double_go::MctsBot>(evaluator, game);
+      return [bot](const std::deque<double_go::Board> &history) {
+        return bot->pick_action(history);
+      };
+    };
+  }
+  return [model, temperature](unsigned seed, double) -> double_go::Player {
+    auto bot = std::make_shared<double_go::PolicyBot>(model, temperature, seed);
+    return [bot](const std::deque<double_go::Board> &history) {
+      return bot->pick_action(history);
+    };
+  };
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::string a_name, b_name;
+  double temperature = 0.5;
+  bool use_sprt = false;
+  double elo0 = 0.0, elo1 = 20.0, alpha = 0.05, beta = 0.05;
+  double_go::MatchConfig config;
+  config.num_games = 400;
+  // Checkpoints play from the policy unless --visits is given.
+  double_go::SearchConfig search;
+  search.visits = 0;
+
+  for (int i = 1; i < argc; ++i) {
+    auto flag = [&](const char *name) {
+      return std::strcmp(argv[i], name) == 0 && i + 1 < argc;
+    };
+    if (flag("--a")) {
+      a_name = argv[++i];
+    } else if (flag("--b")) {
+      b_name = argv[++i];
+    } else if (flag("--games")) {
+      config.num_games = std::atoi(argv[++i]);
+    } else if (flag("--threads")) {
+      config.num_threads = std::atoi(argv[++i]);
+    } else if (flag("--komi")) {
+      config.komis = parse_list(argv[++i]);
+    } else if (flag("--temperature")) {
+      temperature = std::atof(argv[++i]);
+    } else if (flag("--sprt")) {
+      auto bounds = parse_list(argv[++i]);
+      if (bounds.size() != 2) {
+        usage(argv[0]);
+        return 1;
+      }
+      use_sprt = true;
+      elo0 = bounds[0];
+      elo1 = bounds[1];
+    } else if (flag("--alpha")) {
+      alpha = std::atof(argv[++i]);
+    } else if (flag("--beta")) {
+      beta = std::atof(argv[++i]);
+    } else if (flag("--visits")) {
+      search.visits = std::atoi(argv[++i]);
+    } else if (std::strcmp(argv[i], "--macro") == 0) {
+      search.macro_actions = true;
+    } else if (flag("--seed")) {
+      config.seed = static_cast<unsigned>(std::atoll(argv[++i]));
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+  if (a_name.empty() || b_name.empty()) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  PlayerSpec a = load_player(a_name, search);
+  PlayerSpec b = load_player(b_name, search);
+  if (a.model && b.model && a.model->board_size != b.model->board_size) {
+    std::fprintf(stderr, "board sizes differ: %d vs %d\n",
+                 a.model->board_size, b.model->board_size);
+    return 1;
+  }
+  config.board_size = a.model   ? a.model->board_size
+                      : b.model ? b.model->board_size
+                                : config.board_size;
+
+  // Games already run one per core; keep torch from oversubscribing.
+  torch::set_num_threads(1);
+
+  double_go::Sprt sprt(elo0, elo1, alpha, beta);
+  double_go::MatchSummary summary;
+  double_go::run_match(
+      make_factory(a, temperature, search),
+      make_factory(b, temperature, search), config,
+      [&](const double_go::MatchGame &game) {
+        sprt.add(game.score_for_a());
+        summary.add(game);
+        if (!use_sprt)
+          return true;
+        return sprt.status() == double_go::Sprt::Status::Continue;
+      });
+
+  auto wr = double_go::win_rate(summary.wins, summary.draws, summary.losses);
+  std::printf("%s vs %s: %d games (+%d =%d -%d), %d hit the move limit\n",
+              a_name.c_str(), b_name.c_str(), summary.games(), summary.wins,
+              summary.draws, summary.losses, summary.unfinished);
+  std::printf("mean margin %+.2f, mean length %.1f\n", summary.mean_margin(),
+              summary.games() ? double(summary.total_moves()) / summary.games()
+                              : 0.0);
+  // A clean sweep has infinite Elo; report it as half a game short instead.
+  auto elo = [&](double score) {
+    double edge = 0.5 / std::max(summary.games(), 1);
+    return double_go::score_to_elo(std::clamp(score, edge, 1.0 - edge));
+  };
+  std::printf("score %.3f  95%% CI [%.3f, %.3f]  elo %+.1f [%+.1f, %+.1f]\n",
+              wr.score, wr.lower, wr.upper, elo(wr.score), elo(wr.lower),
+              elo(wr.upper));
+  if (use_sprt) {
+    const char *verdict = "inconclusive";
+    if (sprt.status() == double_go::Sprt::Status::AcceptH1)
+      verdict = "H1 accepted (promote)";
+    else if (sprt.status() == double_go::Sprt::Status::AcceptH0)
+      verdict = "H0 accepted (reject)";
+    std::printf("SPRT [%.1f, %.1f] llr %.3f (%.3f, %.3f): %s\n", elo0, elo1,
+                sprt.llr(), sprt.lower_bound(), sprt.upper_bound(), verdict);
+    // Exit status lets scripts gate promotion directly.
+    return sprt.status() == double_go::Sprt::Status::AcceptH1 ? 0 : 2;
+  }
+  return 0;
+}
@@ -5,12 +5,91 @@
 
 namespace double_go {
 
+PositionHistory::PositionHistory(size_t expected_positions) {
+  size_t capacity = 16;
+  while (capacity < 2 * expected_positions)
+    capacity *= 2;
+  slots_.assign(capacity, 0);
+  log_.reserve(expected_positions);
+}
+
+size_t PositionHistory::find_slot(uint64_t key) const {
+  // Zobrist keys are already uniformly distributed; the low bits will do.
+  size_t mask = slots_.size() - 1;
+  size_t i = key & mask;
+  while (slots_[i] != 0 && slots_[i] != key)
+    i = (i + 1) & mask;
+  return i;
+}
+
+bool PositionHistory::contains(uint64_t key) const {
+  uint64_t k = slot_key(key);
+  return slots_[find_slot(k)] == k;
+}
+
+void PositionHistory::insert(uint64_t key) {
+  uint64_t k = slot_key(key);
+  size_t i = find_slot(k);
+  if (slots_[i] == k) {
+    log_.push_back(0);
+    return;
+  }
+  if (2 * (count_ + 1) > slots_.size()) {
+    grow();
+    i = find_slot(k);
+  }
+  slots_[i] = k;
+  ++count_;
+  log_.push_back(k);
+}
+
+void PositionHistory::rollback(size_t mark) {
+  // Keys are removed in reverse insertion order, so each removed key is the
+  // last one on its probe chain and its slot can simply be emptied.
+  while (log_.size() > mark) {
+    uint64_t k = log_.back();
+    log_.pop_back();
+    if (k == 0)
+      continue;
+    slots_[find_slot(k)] = 0;
+    --count_;
+  }
+}
+
+void PositionHistory::grow() {
+  slots_.assign(slots_.size() * 2, 0);
+  // Reinsert in log order to keep rollback's invariant.
+  for (uint64_t k : log_)
+    if (k)
+      slots_[find_slot(k)] = k;
+}
+
 Board::Board(int size) : size_(size), grid_(size * size, Color::Empty) {
   ZobristHash &z = ZobristHash::get_instance();
   assert(size > 0);
   assert(size <= 19);
-  hash_ = z.black_move();
-  set_phase(Phase::First);
+  // phase_ starts as First, so its key is folded in directly; set_phase
+  // would cancel it out.
+  hash_ = z.black_move() ^ z.phase(Phase::First);
+}
+
+uint64_t Board::compute_stone_hash() const {
+  ZobristHash &z = ZobristHash::get_instance();
+  uint64_t h = 0;
+  for (int i = 0; i < size_ * size_; i++)
+    if (grid_[i] != Color::Empty)
+      h ^= z.stone(grid_[i], {i / size_, i % size_});
+  return h;
+}
+
+uint64_t Board::compute_hash() const {
+  ZobristHash &z = ZobristHash::get_instance();
+  uint64_t h = compute_stone_hash() ^ z.phase(phase_);
+  if (to_play_ == Color::Black)
+    h ^= z.black_move();
+  if (ko_point_)
+    h ^= z.ko(*ko_point_);
+  return h;
 }
 
 int Board::captures(Color c) const {
@@ -103,6 +182,7 @@ void Board::remove_group(Point p) {
   stack.push_back(p);
   grid_[index(p)] = Color::Empty;
   hash_ ^= z.stone(color, p);
+  stone_hash_ ^= z.stone(color, p);
   while (!stack.empty()) {
     Point cur = stack.back();
     stack.pop_back();
@@ -115,6 +195,7 @@ void Board::remove_group(Point p) {
       if (grid_[ni] == color) {
         grid_[ni] = Color::Empty;
         hash_ ^= z.stone(color, nbrs[i]);
+        stone_hash_ ^= z.stone(color, nbrs[i]);
         stack.push_back(nbrs[i]);
       }
     }
@@ -122,6 +203,13 @@ void Board::remove_group(Point p) {
 }
 
 bool Board::is_legal(Point p) const {
+  if (!is_legal_ignoring_superko(p))
+    return false;
+  return superko_rule_ == SuperkoRule::None ||
+         !position_history_->contains(superko_key_after(p));
+}
+
+bool Board::is_legal_ignoring_superko(Point p) const {
   if (!is_on_board(p) || grid_[index(p)] != Color::Empty)
     return false;
 
@@ -162,6 +250,57 @@ bool Board::is_legal(Point p) const {
   return false; // suicide
 }
 
+uint64_t Board::superko_key(uint64_t stones, Color mover) const {
+  if (superko_rule_ == SuperkoRule::Situational && mover == Color::Black)
+    return stones ^ ZobristHash::get_instance().black_move();
+  return stones;
+}
+
+uint64_t Board::superko_key_after(Point p) const {
+  ZobristHash &z = ZobristHash::get_instance();
+  Color me = to_play_;
+  Color opp = opponent(me);
+  uint64_t stones = stone_hash_ ^ z.stone(me, p);
+
+  // Opponent groups whose last liberty is p come off the board. This runs
+  // for every is_legal under superko, so it floods each neighbouring group
+  // once into fixed-size buffers instead of allocating.
+  std::array<bool, 19 * 19> seen{};
+  std::array<int16_t, 19 * 19> group;
+  int pi = index(p);
+  Point nbrs[4];
+  int n;
+  neighbors(p, nbrs, n);
+  for (int i = 0; i < n; i++) {
+    int ni = index(nbrs[i]);
+    if (grid_[ni] != opp || seen[ni])
+      continue;
+    int count = 0;
+    bool other_liberty = false;
+    seen[ni] = true;
+    group[count++] = static_cast<int16_t>(ni);
+    for (int k = 0; k < count; k++) {
+      Point cn[4];
+      int cnt;
+      neighbors(point(group[k]), cn, cnt);
+      for (int j = 0; j < cnt; j++) {
+        int ci = index(cn[j]);
+        if (grid_[ci] == Color::Empty && ci != pi) {
+          other_liberty = true;
+        } else if (grid_[ci] == opp && !seen[ci]) {
+          seen[ci] = true;
+          group[count++] = static_cast<int16_t>(ci);
+        }
+      }
+    }
+    if (other_liberty)
+      continue;
+    for (int k = 0; k < count; k++)
+      stones ^= z.stone(opp, point(group[k]));
+  }
+  return superko_key(stones, me);
+}
+
 std::vector<Point> Board::legal_moves() const {
   std::vector<Point> moves;
   for (int r = 0; r < size_; r++)
@@ -176,6 +315,7 @@ void Board::apply_move(Point p) {
 
   grid_[index(p)] = to_play_;
   hash_ ^= z.stone(to_play_, p);
+  stone_hash_ ^= z.stone(to_play_, p);
 
   Color opp = opponent(to_play_);
   int total_captured = 0;
@@ -205,6 +345,23 @@ void Board::apply_move(Point p) {
       group_liberties(p) == 1) {
     set_ko(last_captured);
   }
+
+  if (position_history_)
+    position_history_->insert(superko_key(stone_hash_, to_play_));
+}
+
+void Board::enable_superko(SuperkoRule rule,
+                           std::shared_ptr<PositionHistory> history) {
+  superko_rule_ = rule;
+  if (rule == SuperkoRule::None) {
+    position_history_.reset();
+    return;
+  }
+  position_history_ =
+      history ? std::move(history) : std::make_shared<PositionHistory>();
+  // The current position counts as made by the player who moved last.
+  Color last_mover = phase_ == Phase::Second ? to_play_ : opponent(to_play_);
+  position_history_->insert(superko_key(stone_hash_, last_mover));
 }
 
 void Board::clear_ko() {
@@ -240,57 +397,94 @@ void Board::set_phase(Phase phase) {
 bool Board::game_over() const { return consecutive_passes_ >= 2; }
 
 ScoreResult Board::score(double komi) const {
+  constexpr uint8_t BLACK = 1, WHITE = 2, EMPTY = 4;
   int black_stones = 0, white_stones = 0;
   int black_territory = 0, white_territory = 0;
   int total = size_ * size_;
 
-  for (int i = 0; i < total; i++) {
-    if (grid_[i] == Color::Black)
-      black_stones++;
-    else if (grid_[i] == Color::White)
-      white_stones++;
+  // First pass: count stones and classify every empty point by the colors
+  // around it. In a played-out game almost every empty point is an eye with
+  // no empty neighbour, which settles it without a flood fill.
+  std::array<uint8_t, 19 * 19> borders;
+  auto color_bit = [&](int i) -> uint8_t {
+    Color c = grid_[i];
+    return c == Color::Black ? BLACK : c == Color::White ? WHITE : EMPTY;
+  };
+  int pending = 0;
+  for (int r = 0, i = 0; r < size_; r++) {
+    for (int c = 0; c < size_; c++, i++) {
+      if (grid_[i] == Color::Black) {
+        black_stones++;
+        continue;
+      }
+      if (grid_[i] == Color::White) {
+        white_stones++;
+        continue;
+      }
+      uint8_t mask = 0;
+      if (r > 0)
+        mask |= color_bit(i - size_);
+      if (r < size_ - 1)
+        mask |= color_bit(i + size_);
+      if (c > 0)
+        mask |= color_bit(i - 1);
+      if (c < size_ - 1)
+        mask |= color_bit(i + 1);
+      borders[i] = mask;
+      if (mask == BLACK)
+        black_territory++;
+      else if (mask == WHITE)
+        white_territory++;
+      else if (mask & EMPTY)
+        pending++;
+    }
   }
 
-  std::vector<bool> visited(total, false);
-  for (int i = 0; i < total; i++) {
-    if (visited[i] || grid_[i] != Color::Empty)
-      continue;
-
-    // Flood-fill connected empty region
-    std::vector<int> region;
-    std::vector<int> stack;
-    stack.push_back(i);
-    visited[i] = true;
-    bool borders_black = false, borders_white = false;
-
-    while (!stack.empty()) {
-      int idx = stack.back();
-      stack.pop_back();
-      region.push_back(idx);
-
-      Point p = point(idx);
-      Point nbrs[4];
-      int n;
-      neighbors(p, nbrs, n);
-      for (int j = 0; j < n; j++) {
-        int ni = index(nbrs[j]);
-        if (visited[ni])
+  // Second pass: flood the remaining multi-point regions, using fixed-size
+  // buffers so scoring never allocates.
+  if (pending > 0) {
+    std::array<bool, 19 * 19> visited{};
+    std::array<int16_t, 19 * 19> stack;
+    for (int i = 0; i < total && pending > 0; i++) {
+      if (visited[i] || grid_[i] != Color::Empty || !(borders[i] & EMPTY))
+        continue;
+
+      int top = 0, region = 0;
+      uint8_t mask = 0;
+      stack[top++] = static_cast<int16_t>(i);
+      visited[i] = true;
+      while (top > 0) {
+        int idx = stack[--top];
+        region++;
+        mask |= borders[idx];
+        // Only empty neighbours matter here, and borders[idx] says whether
+        // there are any.
+        if (!(borders[idx] & EMPTY))
           continue;
-        if (grid_[ni] == Color::Empty) {
-          visited[ni] = true;
-          stack.push_back(ni);
-        } else if (grid_[ni] == Color::Black) {
-          borders_black = true;
-        } else {
-          borders_white = true;
-        }
+        int r = idx / size_, c = idx % size_;
+        auto push = [&](int ni) {
+          if (!visited[ni] && grid_[ni] == Color::Empty) {
+            visited[ni] = true;
+            stack[top++] = static_cast<int16_t>(ni);
+          }
+        };
+        if (r > 0)
+          push(idx - size_);
+        if (r < size_ - 1)
+          push(idx + size_);
+        if (c > 0)
+          push(idx - 1);
+        if (c < size_ - 1)
+          push(idx + 1);
       }
-    }
+      pending -= region;
 
-    if (borders_black && !borders_white)
-      black_territory += static_cast<int>(region.size());
-    else if (borders_white && !borders_black)
-      white_territory += static_cast<int>(region.size());
+      mask &= BLACK | WHITE;
+      if (mask == BLACK)
+        black_territory += region;
+      else if (mask == WHITE)
+        white_territory += region;
+    }
   }
 
   ScoreResult result;
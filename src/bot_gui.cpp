@@ -1,9 +1,77 @@
+#include "bot_worker.h"
 #include "gui_common.h"
 
+#include "double-go/players.h"
+
 #include <algorithm>
-#include <random>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace {
+
+void usage(const char *prog) {
+  std::fprintf(stderr,
+               "usage: %s [--black BOT] [--white BOT] [--size N] [--komi X]\n"
+               "          [--visits N] [--macro]\n"
+               "BOT is one of: random, rollout, rollout:WEIGHTS_FILE, mcts,\n"
+               "mcts:WEIGHTS_FILE, gumbel, gumbel:WEIGHTS_FILE. While a\n"
+               "search bot thinks, A cycles the search overlay between\n"
+               "visits, priors and off.\n",
+               prog);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::string black_name = "random", white_name = "random";
+  int board_size = 9;
+  double komi = 6.5;
+  double_go::SearchConfig search;
+
+  for (int i = 1; i < argc; ++i) {
+    auto flag = [&](const char *name) {
+      return std::strcmp(argv[i], name) == 0 && i + 1 < argc;
+    };
+    if (flag("--black")) {
+      black_name = argv[++i];
+    } else if (flag("--white")) {
+      white_name = argv[++i];
+    } else if (flag("--size")) {
+      board_size = std::atoi(argv[++i]);
+    } else if (flag("--komi")) {
+      komi = std::atof(argv[++i]);
+    } else if (flag("--visits")) {
+      search.visits = std::atoi(argv[++i]);
+    } else if (std::strcmp(argv[i], "--macro") == 0) {
+      search.macro_actions = true;
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+  if (board_size < MIN_BOARD_SIZE || board_size > MAX_BOARD_SIZE) {
+    std::fprintf(stderr, "board size must be %d to %d\n", MIN_BOARD_SIZE,
+                 MAX_BOARD_SIZE);
+    return 1;
+  }
 
-int main(int /*argc*/, char * /*argv*/[]) {
+  // The bots think on the worker thread; this loop only handles input and
+  // draws the latest snapshot, plus the search in progress if any.
+  BotWorker worker(board_size, komi);
+  auto black =
+      double_go::make_player_factory(black_name, search, worker.observer());
+  auto white =
+      double_go::make_player_factory(white_name, search, worker.observer());
+  if (!black || !white) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  Layout layout = Layout::initial(board_size);
   if (SDL_Init(SDL_INIT_VIDEO) != 0) {
     SDL_Log("SDL_Init failed: %s", SDL_GetError());
     return 1;
@@ -11,15 +79,19 @@ int main(int /*argc*/, char * /*argv*/[]) {
 
   SDL_Window *window =
       SDL_CreateWindow("Double Go - Bot vs Bot", SDL_WINDOWPOS_CENTERED,
-                       SDL_WINDOWPOS_CENTERED, WIN_W, WIN_H, SDL_WINDOW_SHOWN);
+                       SDL_WINDOWPOS_CENTERED, layout.width, layout.height,
+                       SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
   if (!window) {
     SDL_Log("SDL_CreateWindow failed: %s", SDL_GetError());
     SDL_Quit();
     return 1;
   }
+  SDL_SetWindowMinimumSize(window, 320, 400);
 
   SDL_Renderer *renderer = SDL_CreateRenderer(
-      window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+      window, -1,
+      SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC |
+          SDL_RENDERER_TARGETTEXTURE);
   if (!renderer) {
     SDL_Log("SDL_CreateRenderer failed: %s", SDL_GetError());
     SDL_DestroyWindow(window);
@@ -27,19 +99,19 @@ int main(int /*argc*/, char * /*argv*/[]) {
     return 1;
   }
 
-  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-
-  std::random_device rd;
-  double_go::RandomBot black_bot(rd());
-  double_go::RandomBot white_bot(rd());
+  if (!SDL_RenderTargetSupported(renderer)) {
+    SDL_Log("renderer does not support render targets");
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+    return 1;
+  }
 
-  double_go::Board board(BOARD_SIZE);
-  std::optional<double_go::Point> last_move;
-  double komi = 6.5;
+  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+  auto view = std::make_unique<BoardRenderer>(renderer, layout);
 
-  bool paused = false;
-  Uint32 move_delay_ms = 200;
-  Uint32 last_move_time = SDL_GetTicks();
+  worker.start(black, white);
+  std::optional<Heatmap> heatmap = Heatmap::Visits;
 
   bool running = true;
   while (running) {
@@ -50,6 +122,17 @@ int main(int /*argc*/, char * /*argv*/[]) {
         running = false;
         break;
 
+      case SDL_RENDER_TARGETS_RESET:
+      case SDL_RENDER_DEVICE_RESET:
+        view->invalidate();
+        break;
+
+      case SDL_WINDOWEVENT:
+        if (event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+          view->set_layout(Layout::fit(board_size, event.window.data1,
+                                       event.window.data2));
+        break;
+
       case SDL_KEYDOWN:
         switch (event.key.keysym.sym) {
         case SDLK_q:
@@ -57,20 +140,25 @@ int main(int /*argc*/, char * /*argv*/[]) {
           running = false;
           break;
         case SDLK_r:
-          black_bot = double_go::RandomBot(rd());
-          white_bot = double_go::RandomBot(rd());
-          board = double_go::Board(BOARD_SIZE);
-          last_move = std::nullopt;
-          last_move_time = SDL_GetTicks();
+          worker.reset();
           break;
         case SDLK_SPACE:
-          paused = !paused;
+          worker.set_paused(!worker.paused());
+          break;
+        case SDLK_a:
+          // Search overlay: visits, then priors, then off.
+          if (!heatmap)
+            heatmap = Heatmap::Visits;
+          else if (*heatmap == Heatmap::Visits)
+            heatmap = Heatmap::Priors;
+          else
+            heatmap.reset();
           break;
         case SDLK_UP:
-          move_delay_ms = std::max(20u, move_delay_ms / 2);
+          worker.set_move_delay_ms(std::max(20, worker.move_delay_ms() / 2));
           break;
         case SDLK_DOWN:
-          move_delay_ms = std::min(2000u, move_delay_ms * 2);
+          worker.set_move_delay_ms(std::min(2000, worker.move_delay_ms() * 2));
           break;
         default:
           break;
@@ -82,29 +170,21 @@ int main(int /*argc*/, char * /*argv*/[]) {
       }
     }
 
-    // Auto-play on timer
-    if (!paused && !board.game_over()) {
-      Uint32 now = SDL_GetTicks();
-      if (now - last_move_time >= move_delay_ms) {
-        auto &bot = (board.to_play() == double_go::Color::Black) ? black_bot
-                                                                 : white_bot;
-        auto action = bot.pick_action(board);
-        board.apply(action);
-        if (action.type == double_go::ActionType::Place) {
-          last_move = action.point;
-        } else {
-          last_move = std::nullopt;
-        }
-        last_move_time = now;
-      }
-    }
+    worker.poll();
+    worker.poll_search();
+    const GameSnapshot &snap = worker.snapshot();
+    const SearchSnapshot &search_snap = worker.search();
 
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
     SDL_RenderClear(renderer);
-    render_board(renderer, board, last_move, std::nullopt, komi);
+    view->render(snap.board, snap.last_move(), std::nullopt, komi,
+                 &snap.score);
+    if (heatmap && search_snap.hash == snap.board.hash())
+      view->draw_analysis(snap.board, search_snap.result, *heatmap);
     SDL_RenderPresent(renderer);
   }
 
+  view.reset();
   SDL_DestroyRenderer(renderer);
   SDL_DestroyWindow(window);
   SDL_Quit();
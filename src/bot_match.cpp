@@ -0,0 +1,192 @@
+#include "double-go/double-go.h"
+#include "double-go/match.h"
+#include "double-go/players.h"
+#include "double-go/record.h"
+#include "double-go/sgf.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+void usage(const char *prog) {
+  std::fprintf(stderr,
+               "usage: %s [--a BOT] [--b BOT] [--size N] [--games N]\n"
+               "          [--threads N] [--komi X[,X...]] [--max-moves N]\n"
+               "          [--superko positional|situational] [--settle]\n"
+               "          [--visits N] [--macro] [--early-stop] [--seed N]\n"
+               "          [--record FILE]\n"
+               "BOT is one of: random, rollout, rollout:WEIGHTS_FILE, mcts,\n"
+               "mcts:WEIGHTS_FILE, gumbel, gumbel:WEIGHTS_FILE. mcts searches\n"
+               "--visits simulations per move with rollout evaluations, and\n"
+               "gumbel does too with Gumbel root selection; --macro searches\n"
+               "two-stone turns as one action; --early-stop ends an mcts\n"
+               "search once its best move is decided. --record writes every\n"
+               "game to FILE for double-go-gui --replay, as SGF if FILE ends\n"
+               "in .sgf.\n",
+               prog);
+}
+
+std::vector<double> parse_list(const char *s) {
+  std::vector<double> out;
+  std::stringstream ss(s);
+  std::string item;
+  while (std::getline(ss, item, ','))
+    out.push_back(std::atof(item.c_str()));
+  return out;
+}
+
+void print_histogram(const std::vector<int> &lengths, int max_moves) {
+  constexpr int BUCKETS = 10;
+  constexpr int BAR_WIDTH = 40;
+  int width = std::max(1, (max_moves + BUCKETS - 1) / BUCKETS);
+  std::vector<int> counts(BUCKETS + 1, 0);
+  for (int n : lengths)
+    ++counts[std::min(BUCKETS, n / width)];
+  int peak = 1;
+  for (int c : counts)
+    peak = std::max(peak, c);
+  for (int b = 0; b <= BUCKETS; ++b) {
+    if (counts[b] == 0)
+      continue;
+    std::string bar(counts[b] * BAR_WIDTH / peak, '#');
+    if (b < BUCKETS)
+      std::printf("  %5d-%-5d %7d %s\n", b * width, (b + 1) * width - 1,
+                  counts[b], bar.c_str());
+    else
+      std::printf("  %5d+      %7d %s\n", b * width, counts[b], bar.c_str());
+  }
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::string a_name = "random", b_name = "random";
+  double_go::MatchConfig config;
+  config.num_games = 1000;
+  double_go::SearchConfig search;
+  std::string record_path;
+
+  for (int i = 1; i < argc; ++i) {
+    auto flag = [&](const char *name) {
+      return std::strcmp(argv[i], name) == 0 && i + 1 < argc;
+    };
+    if (flag("--a")) {
+      a_name = argv[++i];
+    } else if (flag("--b")) {
+      b_name = argv[++i];
+    } else if (flag("--size")) {
+      config.board_size = std::atoi(argv[++i]);
+    } else if (flag("--games")) {
+      config.num_games = std::atoi(argv[++i]);
+    } else if (flag("--threads")) {
+      config.num_threads = std::atoi(argv[++i]);
+    } else if (flag("--komi")) {
+      config.komis = parse_list(argv[++i]);
+    } else if (flag("--max-moves")) {
+      config.max_moves = std::atoi(argv[++i]);
+    } else if (flag("--superko")) {
+      std::string rule = argv[++i];
+      if (rule == "positional") {
+        config.superko = double_go::SuperkoRule::Positional;
+      } else if (rule == "situational") {
+        config.superko = double_go::SuperkoRule::Situational;
+      } else {
+        usage(argv[0]);
+        return 1;
+      }
+    } else if (std::strcmp(argv[i], "--settle") == 0) {
+      config.stop_when_settled = true;
+    } else if (flag("--visits")) {
+      search.visits = std::atoi(argv[++i]);
+    } else if (std::strcmp(argv[i], "--macro") == 0) {
+      search.macro_actions = true;
+    } else if (std::strcmp(argv[i], "--early-stop") == 0) {
+      search.early_stop = true;
+    } else if (flag("--seed")) {
+      config.seed = static_cast<unsigned>(std::atoll(argv[++i]));
+    } else if (flag("--record")) {
+      record_path = argv[++i];
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  auto a = double_go::make_player_factory(a_name, search);
+  auto b = double_go::make_player_factory(b_name, search);
+  if (!a || !b || config.board_size < 1 || config.board_size > 19) {
+    usage(argv[0]);
+    return 1;
+  }
+  int max_moves = config.max_moves > 0
+                      ? config.max_moves
+                      : 4 * config.board_size * config.board_size;
+
+  std::ofstream records;
+  double_go::SgfWriter sgf(records);
+  bool write_sgf = record_path.ends_with(".sgf");
+  if (!record_path.empty()) {
+    records.open(record_path, std::ios::trunc);
+    if (!records) {
+      std::fprintf(stderr, "cannot open %s\n", record_path.c_str());
+      return 1;
+    }
+  }
+
+  double_go::MatchSummary summary;
+  auto start = std::chrono::steady_clock::now();
+  double_go::run_match(a, b, config, [&](const double_go::MatchGame &game) {
+    summary.add(game);
+    if (records.is_open()) {
+      double_go::GameRecord record(config.board_size, game.komi);
+      for (auto action : game.result.actions)
+        record.add(action);
+      if (write_sgf)
+        sgf.write(record);
+      else
+        double_go::write_record(records, record);
+    }
+    return true;
+  });
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+  auto wr = double_go::win_rate(summary.wins, summary.draws, summary.losses);
+  std::printf("%s vs %s on %dx%d: %d games\n", a_name.c_str(),
+              b_name.c_str(), config.board_size, config.board_size,
+              summary.games());
+  std::printf("  a: +%d =%d -%d  score %.3f [%.3f, %.3f]\n", summary.wins,
+              summary.draws, summary.losses, wr.score, wr.lower, wr.upper);
+  std::printf("  a as black: %d/%d wins, as white: %d/%d wins\n",
+              summary.wins_as_black, summary.games_as_black,
+              summary.wins - summary.wins_as_black,
+              summary.games() - summary.games_as_black);
+  std::printf("  margin (a - b): mean %+.2f, stddev %.2f\n",
+              summary.mean_margin(), summary.margin_stddev());
+  std::printf("  length: mean %.1f, p10 %d, p50 %d, p90 %d, max %d, "
+              "%d hit the %d move limit\n",
+              summary.games() ? double(summary.total_moves()) / summary.games()
+                              : 0.0,
+              summary.length_percentile(0.1),
+              summary.length_percentile(0.5),
+              summary.length_percentile(0.9),
+              summary.length_percentile(1.0), summary.unfinished, max_moves);
+  if (config.stop_when_settled)
+    std::printf("  %d stopped early with the result settled\n",
+                summary.settled);
+  print_histogram(summary.game_lengths, max_moves);
+  std::printf("  throughput: %.1f games/s, %.0f moves/s (%.2fs)\n",
+              summary.games() / seconds, summary.total_moves() / seconds,
+              seconds);
+  return 0;
+}
@@ -0,0 +1,80 @@
+#include "bot_worker.h"
+
+BotWorker::BotWorker(int board_size, double komi)
+    : board_size_(board_size), komi_(komi) {}
+
+BotWorker::~BotWorker() {
+  stop_.store(true);
+  if (thread_.joinable())
+    thread_.join();
+}
+
+double_go::SearchObserver BotWorker::observer() {
+  // Runs on the worker thread, inside the player's search of
+  // history_.back().
+  return [this](const double_go::SearchResult &result) {
+    SearchSnapshot &snap = searches_.write_slot();
+    snap.hash = history_.back().hash();
+    snap.result = result;
+    searches_.publish();
+  };
+}
+
+void BotWorker::start(double_go::PlayerFactory black,
+                      double_go::PlayerFactory white) {
+  black_factory_ = std::move(black);
+  white_factory_ = std::move(white);
+  new_game();
+  thread_ = std::thread([this] { run(); });
+}
+
+void BotWorker::new_game() {
+  black_ = black_factory_(seeds_(), komi_);
+  white_ = white_factory_(seeds_(), komi_);
+  history_.assign(1, double_go::Board(board_size_));
+  last_move_time_ = std::chrono::steady_clock::now();
+  publish(std::nullopt);
+}
+
+void BotWorker::publish(std::optional<double_go::Action> last_action) {
+  GameSnapshot &snap = snapshots_.write_slot();
+  snap.board = history_.back();
+  snap.last_action = last_action;
+  snap.score = history_.back().score(komi_);
+  snap.moves = static_cast<int>(history_.size()) - 1;
+  snapshots_.publish();
+}
+
+void BotWorker::run() {
+  constexpr auto TICK = std::chrono::milliseconds(10);
+  while (!stop_.load()) {
+    unsigned resets = resets_.load();
+    if (resets != seen_resets_) {
+      seen_resets_ = resets;
+      new_game();
+      continue;
+    }
+
+    const double_go::Board &board = history_.back();
+    auto due = last_move_time_ + std::chrono::milliseconds(delay_ms_.load());
+    if (paused_.load() || board.game_over() ||
+        std::chrono::steady_clock::now() < due) {
+      std::this_thread::sleep_for(TICK);
+      continue;
+    }
+
+    auto &player = board.to_play() == double_go::Color::Black ? black_ : white_;
+    double_go::Action action = player(history_);
+    if (resets_.load() != seen_resets_)
+      continue;
+
+    double_go::Board next = board;
+    if (!next.apply(action)) {
+      action = double_go::Action::pass();
+      next.apply(action);
+    }
+    history_.push_back(std::move(next));
+    last_move_time_ = std::chrono::steady_clock::now();
+    publish(action);
+  }
+}
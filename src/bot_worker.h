@@ -0,0 +1,99 @@
+#pragma once
+
+#include "double-go/match.h"
+#include "double-go/search.h"
+#include "double-go/triple_buffer.h"
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <optional>
+#include <random>
+#include <thread>
+
+// What the UI shows of a game in progress.
+struct GameSnapshot {
+  double_go::Board board{};
+  std::optional<double_go::Action> last_action;
+  double_go::ScoreResult score{};
+  int moves = 0;
+
+  std::optional<double_go::Point> last_move() const {
+    if (last_action && last_action->type == double_go::ActionType::Place)
+      return last_action->point;
+    return std::nullopt;
+  }
+};
+
+// A search in progress, for the position with the given hash.
+struct SearchSnapshot {
+  uint64_t hash = 0;
+  double_go::SearchResult result;
+};
+
+// Plays bot-vs-bot games on its own thread, so the UI thread only renders.
+// Every action played is published as a snapshot through a triple buffer,
+// and the UI steers the worker through atomics; neither side ever blocks
+// the other. A command arriving while a bot is thinking takes effect once
+// it returns; a reset throws its answer away.
+//
+// Search players built with observer() also stream their progress through
+// a second triple buffer, at the rate the observer is throttled to.
+class BotWorker {
+public:
+  BotWorker(int board_size, double komi);
+  ~BotWorker();
+  BotWorker(const BotWorker &) = delete;
+  BotWorker &operator=(const BotWorker &) = delete;
+
+  // For the players' factories: publishes each search report as a
+  // SearchSnapshot of the position being searched.
+  double_go::SearchObserver observer();
+
+  // Sets up the first game and starts the thread. Call once.
+  void start(double_go::PlayerFactory black, double_go::PlayerFactory white);
+
+  // UI thread: pulls the newest snapshot into snapshot(). Returns true if it
+  // changed since the last call.
+  bool poll() { return snapshots_.update(); }
+  const GameSnapshot &snapshot() const { return snapshots_.read_slot(); }
+  // Likewise for search reports.
+  bool poll_search() { return searches_.update(); }
+  const SearchSnapshot &search() const { return searches_.read_slot(); }
+
+  bool paused() const { return paused_.load(std::memory_order_relaxed); }
+  void set_paused(bool paused) { paused_.store(paused); }
+  int move_delay_ms() const {
+    return delay_ms_.load(std::memory_order_relaxed);
+  }
+  void set_move_delay_ms(int ms) { delay_ms_.store(ms); }
+  // Starts a new game with fresh bots.
+  void reset() { resets_.fetch_add(1); }
+
+private:
+  void run();
+  void new_game();
+  void publish(std::optional<double_go::Action> last_action);
+
+  double_go::PlayerFactory black_factory_;
+  double_go::PlayerFactory white_factory_;
+  int board_size_;
+  double komi_;
+
+  // Worker thread state. start() sets up the first game before launching
+  // the thread, so a snapshot is ready before the UI polls.
+  std::random_device seeds_;
+  double_go::Player black_;
+  double_go::Player white_;
+  std::deque<double_go::Board> history_;
+  std::chrono::steady_clock::time_point last_move_time_;
+  unsigned seen_resets_ = 0;
+
+  double_go::TripleBuffer<GameSnapshot> snapshots_;
+  double_go::TripleBuffer<SearchSnapshot> searches_;
+  std::atomic<bool> stop_{false};
+  std::atomic<bool> paused_{false};
+  std::atomic<int> delay_ms_{200};
+  std::atomic<unsigned> resets_{0};
+  std::thread thread_;
+};
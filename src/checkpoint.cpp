@@ -0,0 +1,327 @@
+#include "double-go/checkpoint.h"
+
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace double_go {
+
+static_assert(std::endian::native == std::endian::little,
+              "checkpoints are stored little-endian");
+
+namespace {
+
+constexpr char MAGIC[8] = {'D', 'G', 'O', 'C', 'K', 'P', 'T', '\0'};
+
+enum class DType : uint32_t { Float32 = 0, Int64 = 1 };
+
+// Fixed-size part at the start of the file.
+struct FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t flags; // reserved, written as 0
+  uint32_t board_size;
+  uint32_t num_blocks;
+  uint32_t num_channels;
+  uint32_t history_len;
+  uint32_t num_tensors;
+  uint32_t reserved;
+  uint64_t data_offset;
+};
+
+struct TensorEntry {
+  std::string name;
+  DType dtype;
+  std::vector<int64_t> shape;
+  uint64_t offset; // relative to the data section
+  uint64_t nbytes;
+};
+
+uint64_t align_up(uint64_t n) {
+  return (n + CHECKPOINT_ALIGNMENT - 1) / CHECKPOINT_ALIGNMENT *
+         CHECKPOINT_ALIGNMENT;
+}
+
+[[noreturn]] void fail(const std::string &path, const std::string &what) {
+  throw std::runtime_error("checkpoint " + path + ": " + what);
+}
+
+CheckpointInfo to_info(const FileHeader &h) {
+  return {h.version, static_cast<int>(h.board_size),
+          static_cast<int>(h.num_blocks), static_cast<int>(h.num_channels),
+          static_cast<int>(h.history_len)};
+}
+
+void validate(const FileHeader &h, const std::string &path) {
+  if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0)
+    fail(path, "bad magic");
+  if (h.version == 0 || h.version > CHECKPOINT_VERSION)
+    fail(path, "unsupported version " + std::to_string(h.version));
+  if (h.history_len != Model::HISTORY_LEN)
+    fail(path, "history length " + std::to_string(h.history_len) +
+                   " does not match this build");
+  if (h.board_size == 0 || h.board_size > 19)
+    fail(path, "bad board size");
+}
+
+// Bounds-checked cursor over the tensor index.
+class IndexReader {
+public:
+  IndexReader(const uint8_t *begin, const uint8_t *end, const std::string &path)
+      : cur_(begin), end_(end), path_(path) {}
+
+  template <typename T> T read() {
+    T v;
+    take(&v, sizeof(T));
+    return v;
+  }
+
+  std::string read_string() {
+    uint32_t len = read<uint32_t>();
+    std::string s(len, '\0');
+    take(s.data(), len);
+    return s;
+  }
+
+private:
+  void take(void *out, size_t n) {
+    if (static_cast<size_t>(end_ - cur_) < n)
+      fail(path_, "truncated index");
+    std::memcpy(out, cur_, n);
+    cur_ += n;
+  }
+
+  const uint8_t *cur_;
+  const uint8_t *end_;
+  const std::string &path_;
+};
+
+// File contents backing the loaded tensors. Tensors keep a reference, so the
+// mapping lives exactly as long as any weight still points into it.
+class FileBlob {
+public:
+  virtual ~FileBlob() = default;
+  uint8_t *data() const { return data_; }
+  size_t size() const { return size_; }
+
+protected:
+  uint8_t *data_ = nullptr;
+  size_t size_ = 0;
+};
+
+class MappedBlob : public FileBlob {
+public:
+  explicit MappedBlob(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      fail(path, "cannot open");
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      ::close(fd);
+      fail(path, "cannot stat");
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    // Read-only: fusing folds into fresh tensors, so nothing writes here.
+    void *p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED)
+      fail(path, "mmap failed");
+    data_ = static_cast<uint8_t *>(p);
+  }
+
+  ~MappedBlob() override { ::munmap(data_, size_); }
+};
+
+class HeapBlob : public FileBlob {
+public:
+  explicit HeapBlob(const std::string &path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in)
+      fail(path, "cannot open");
+    bytes_.resize(static_cast<size_t>(in.tellg()));
+    in.seekg(0);
+    in.read(reinterpret_cast<char *>(bytes_.data()), bytes_.size());
+    if (!in)
+      fail(path, "read failed");
+    data_ = bytes_.data();
+    size_ = bytes_.size();
+  }
+
+private:
+  std::vector<uint8_t> bytes_;
+};
+
+torch::ScalarType scalar_type(DType dtype, const std::string &path) {
+  switch (dtype) {
+  case DType::Float32:
+    return torch::kFloat;
+  case DType::Int64:
+    return torch::kLong;
+  }
+  fail(path, "unknown dtype");
+}
+
+} // namespace
+
+void save_checkpoint(const Model &model, const std::string &path) {
+  if (model.is_fused()) {
+    throw std::invalid_argument("cannot checkpoint a fused model");
+  }
+
+  std::vector<std::pair<std::string, Tensor>> tensors;
+  for (const auto &p : model.named_parameters())
+    tensors.emplace_back(p.key(), p.value().detach().cpu().contiguous());
+  for (const auto &b : model.named_buffers())
+    tensors.emplace_back(b.key(), b.value().detach().cpu().contiguous());
+
+  std::vector<TensorEntry> entries;
+  uint64_t index_size = 0;
+  uint64_t data_size = 0;
+  for (const auto &[name, t] : tensors) {
+    TensorEntry e;
+    e.name = name;
+    if (t.scalar_type() == torch::kFloat)
+      e.dtype = DType::Float32;
+    else if (t.scalar_type() == torch::kLong)
+      e.dtype = DType::Int64;
+    else
+      throw std::invalid_argument("unsupported dtype for tensor " + name);
+    e.shape.assign(t.sizes().begin(), t.sizes().end());
+    e.offset = data_size;
+    e.nbytes = t.numel() * t.element_size();
+    data_size = align_up(data_size + e.nbytes);
+    index_size += sizeof(uint32_t) + name.size() + 2 * sizeof(uint32_t) +
+                  e.shape.size() * sizeof(int64_t) + 2 * sizeof(uint64_t);
+    entries.push_back(std::move(e));
+  }
+
+  FileHeader h{};
+  std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+  h.version = CHECKPOINT_VERSION;
+  h.board_size = model.board_size;
+  h.num_blocks = model.num_blocks;
+  h.num_channels = model.num_channels;
+  h.history_len = Model::HISTORY_LEN;
+  h.num_tensors = static_cast<uint32_t>(entries.size());
+  h.data_offset = align_up(sizeof(FileHeader) + index_size);
+
+  // Write next to the destination and rename, so a process loading the
+  // checkpoint never observes a partial file.
+  std::string tmp = path + ".tmp";
+  {
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    if (!out)
+      fail(tmp, "cannot open for writing");
+    auto put = [&](const void *p, size_t n) {
+      out.write(static_cast<const char *>(p), n);
+    };
+    auto pad_to = [&](uint64_t pos) {
+      static const char zeros[CHECKPOINT_ALIGNMENT] = {};
+      uint64_t cur = static_cast<uint64_t>(out.tellp());
+      put(zeros, pos - cur);
+    };
+
+    put(&h, sizeof(h));
+    for (const auto &e : entries) {
+      uint32_t len = static_cast<uint32_t>(e.name.size());
+      uint32_t ndim = static_cast<uint32_t>(e.shape.size());
+      put(&len, sizeof(len));
+      put(e.name.data(), len);
+      put(&e.dtype, sizeof(e.dtype));
+      put(&ndim, sizeof(ndim));
+      put(e.shape.data(), ndim * sizeof(int64_t));
+      put(&e.offset, sizeof(e.offset));
+      put(&e.nbytes, sizeof(e.nbytes));
+    }
+    for (size_t i = 0; i < entries.size(); ++i) {
+      pad_to(h.data_offset + entries[i].offset);
+      put(tensors[i].second.data_ptr(), entries[i].nbytes);
+    }
+    if (!out)
+      fail(tmp, "write failed");
+  }
+  std::filesystem::rename(tmp, path);
+}
+
+CheckpointInfo read_checkpoint_info(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in)
+    fail(path, "cannot open");
+  FileHeader h;
+  if (!in.read(reinterpret_cast<char *>(&h), sizeof(h)))
+    fail(path, "truncated header");
+  validate(h, path);
+  return to_info(h);
+}
+
+std::shared_ptr<Model> load_checkpoint(const std::string &path,
+                                       const LoadOptions &options) {
+  std::shared_ptr<FileBlob> blob;
+  if (options.mmap)
+    blob = std::make_shared<MappedBlob>(path);
+  else
+    blob = std::make_shared<HeapBlob>(path);
+
+  if (blob->size() < sizeof(FileHeader))
+    fail(path, "truncated header");
+  FileHeader h;
+  std::memcpy(&h, blob->data(), sizeof(h));
+  validate(h, path);
+  if (h.data_offset > blob->size() || h.data_offset % CHECKPOINT_ALIGNMENT)
+    fail(path, "bad data offset");
+
+  auto model = std::make_shared<Model>(h.board_size, h.num_blocks,
+                                       h.num_channels);
+  torch::NoGradGuard no_grad;
+  auto params = model->named_parameters();
+  auto buffers = model->named_buffers();
+
+  IndexReader index(blob->data() + sizeof(FileHeader),
+                    blob->data() + h.data_offset, path);
+  uint8_t *data = blob->data() + h.data_offset;
+  uint64_t data_size = blob->size() - h.data_offset;
+  for (uint32_t i = 0; i < h.num_tensors; ++i) {
+    std::string name = index.read_string();
+    auto dtype = index.read<DType>();
+    auto ndim = index.read<uint32_t>();
+    std::vector<int64_t> shape(ndim);
+    for (auto &d : shape)
+      d = index.read<int64_t>();
+    auto offset = index.read<uint64_t>();
+    auto nbytes = index.read<uint64_t>();
+
+    Tensor *target = params.find(name);
+    if (!target)
+      target = buffers.find(name);
+    if (!target)
+      fail(path, "unexpected tensor " + name);
+    if (target->sizes() != torch::IntArrayRef(shape) ||
+        target->scalar_type() != scalar_type(dtype, path))
+      fail(path, "tensor " + name + " does not match the architecture");
+    if (offset > data_size || nbytes > data_size - offset ||
+        nbytes != target->numel() * target->element_size())
+      fail(path, "tensor " + name + " out of bounds");
+
+    // Zero-copy: the weight points straight into the file contents.
+    target->set_data(torch::from_blob(
+        data + offset, shape, [blob](void *) {},
+        torch::TensorOptions().dtype(scalar_type(dtype, path))));
+  }
+  if (h.num_tensors != params.size() + buffers.size())
+    fail(path, "missing tensors");
+
+  model->eval();
+  if (options.fuse)
+    model->fuse();
+  return model;
+}
+
+} // namespace double_go
@@ -0,0 +1,405 @@
+#include "double-go/gtp.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+
+namespace double_go {
+
+namespace {
+
+constexpr const char *COMMANDS[] = {
+    "protocol_version", "name",        "version",      "known_command",
+    "list_commands",    "quit",        "boardsize",    "clear_board",
+    "komi",             "play",        "genmove",      "undo",
+    "showboard",        "final_score", "time_settings", "time_left",
+    "dg-phase",         "dg-genturn",
+};
+
+std::string lower(std::string s) {
+  for (char &c : s)
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  return s;
+}
+
+// A number with nothing after it.
+bool parse_int(const std::string &s, int &out) {
+  char *end = nullptr;
+  long v = std::strtol(s.c_str(), &end, 10);
+  if (s.empty() || *end != '\0')
+    return false;
+  out = static_cast<int>(v);
+  return true;
+}
+
+bool parse_double(const std::string &s, double &out) {
+  char *end = nullptr;
+  out = std::strtod(s.c_str(), &end);
+  return !s.empty() && *end == '\0';
+}
+
+std::string format_points(double v) {
+  char buf[32];
+  if (v == static_cast<int>(v))
+    std::snprintf(buf, sizeof(buf), "%d", static_cast<int>(v));
+  else
+    std::snprintf(buf, sizeof(buf), "%.1f", v);
+  return buf;
+}
+
+const char *phase_name(Phase p) {
+  switch (p) {
+  case Phase::Bonus:
+    return "bonus";
+  case Phase::First:
+    return "first";
+  case Phase::Second:
+    return "second";
+  }
+  return "";
+}
+
+} // namespace
+
+// ── Vertices ────────────────────────────────────────────────────────────────
+
+std::optional<Action> parse_vertex(const std::string &text, int size) {
+  std::string v = lower(text);
+  if (v == "pass")
+    return Action::pass();
+  if (v.size() < 2 || v[0] < 'a' || v[0] > 'z' || v[0] == 'i')
+    return std::nullopt;
+  int col = v[0] - 'a' - (v[0] > 'i' ? 1 : 0);
+  int number;
+  if (!parse_int(v.substr(1), number) || col >= size || number < 1 ||
+      number > size)
+    return std::nullopt;
+  return Action::place({size - number, col});
+}
+
+std::string format_vertex(Action a, int size) {
+  if (a.type == ActionType::Pass)
+    return "pass";
+  char letter = static_cast<char>('A' + a.point.col + (a.point.col >= 8));
+  return letter + std::to_string(size - a.point.row);
+}
+
+// ── GtpEngine ───────────────────────────────────────────────────────────────
+
+GtpEngine::GtpEngine(GtpConfig config)
+    : config_(std::move(config)),
+      next_seed_(config_.seed ? config_.seed : std::random_device{}()),
+      time_manager_(config_.time) {
+  clear_board();
+}
+
+void GtpEngine::clear_board() {
+  history_.assign(1, Board(config_.board_size));
+  if (config_.superko != SuperkoRule::None)
+    history_.back().enable_superko(config_.superko);
+  superko_marks_.clear();
+  bot_.reset();
+}
+
+std::string GtpEngine::execute(const std::string &line) {
+  std::string text = line.substr(0, line.find('#'));
+  for (char &c : text)
+    if (c == '\t' || c == '\r')
+      c = ' ';
+  std::istringstream tokens(text);
+  std::vector<std::string> words;
+  for (std::string w; tokens >> w;)
+    words.push_back(w);
+  if (words.empty())
+    return "";
+
+  std::string id;
+  if (std::all_of(words[0].begin(), words[0].end(),
+                  [](unsigned char c) { return std::isdigit(c); })) {
+    id = words[0];
+    words.erase(words.begin());
+    if (words.empty())
+      return "?" + id + " missing command\n\n";
+  }
+  std::string command = words[0];
+  words.erase(words.begin());
+
+  std::string out;
+  bool ok = dispatch(command, words, out);
+  std::string response = (ok ? "=" : "?") + id;
+  if (!out.empty())
+    response += " " + out;
+  return response + "\n\n";
+}
+
+void GtpEngine::run(std::istream &in, std::ostream &out) {
+  for (std::string line; !quit_ && std::getline(in, line);) {
+    std::string response = execute(line);
+    if (!response.empty())
+      out << response << std::flush;
+  }
+}
+
+std::optional<Color> GtpEngine::parse_color(const std::string &text) const {
+  std::string c = lower(text);
+  if (c == "b" || c == "black")
+    return Color::Black;
+  if (c == "w" || c == "white")
+    return Color::White;
+  return std::nullopt;
+}
+
+bool GtpEngine::dispatch(const std::string &command,
+                         const std::vector<std::string> &args,
+                         std::string &out) {
+  auto expect = [&](size_t n) {
+    if (args.size() == n)
+      return true;
+    out = "expected " + std::to_string(n) + " argument" + (n == 1 ? "" : "s");
+    return false;
+  };
+
+  if (command == "protocol_version") {
+    out = "2";
+  } else if (command == "name") {
+    out = "double-go";
+  } else if (command == "version") {
+    out = "1";
+  } else if (command == "known_command") {
+    if (!expect(1))
+      return false;
+    out = std::find(std::begin(COMMANDS), std::end(COMMANDS), args[0]) !=
+                  std::end(COMMANDS)
+              ? "true"
+              : "false";
+  } else if (command == "list_commands") {
+    for (const char *c : COMMANDS)
+      out += (out.empty() ? "" : "\n") + std::string(c);
+  } else if (command == "quit") {
+    quit_ = true;
+  } else if (command == "boardsize") {
+    int size;
+    if (!expect(1))
+      return false;
+    if (!parse_int(args[0], size) || size < 2 || size > 19) {
+      out = "unacceptable size";
+      return false;
+    }
+    config_.board_size = size;
+    clear_board();
+  } else if (command == "clear_board") {
+    clear_board();
+  } else if (command == "komi") {
+    double komi;
+    if (!expect(1))
+      return false;
+    if (!parse_double(args[0], komi)) {
+      out = "syntax error";
+      return false;
+    }
+    config_.komi = komi;
+    bot_.reset();
+  } else if (command == "play") {
+    return play(args, out);
+  } else if (command == "genmove") {
+    return genmove(args, false, out);
+  } else if (command == "dg-genturn") {
+    return genmove(args, true, out);
+  } else if (command == "undo") {
+    if (history_.size() <= 1) {
+      out = "cannot undo";
+      return false;
+    }
+    history_.pop_back();
+    if (const auto &positions = board().position_history())
+      positions->rollback(superko_marks_.back());
+    superko_marks_.pop_back();
+  } else if (command == "showboard") {
+    out = showboard();
+  } else if (command == "final_score") {
+    auto sr = board().score(config_.komi);
+    double margin = sr.black_score - sr.white_score;
+    out = margin > 0   ? "B+" + format_points(margin)
+          : margin < 0 ? "W+" + format_points(-margin)
+                       : "0";
+  } else if (command == "time_settings") {
+    TimeControl tc;
+    if (!expect(3))
+      return false;
+    if (!parse_double(args[0], tc.main_time) ||
+        !parse_double(args[1], tc.byo_yomi_time) ||
+        !parse_int(args[2], tc.byo_yomi_stones)) {
+      out = "syntax error";
+      return false;
+    }
+    time_control_ = tc;
+    clocks_[0] = clocks_[1] = initial_clock(tc);
+  } else if (command == "time_left") {
+    if (!expect(3))
+      return false;
+    auto color = parse_color(args[0]);
+    double seconds;
+    int stones;
+    if (!color || !parse_double(args[1], seconds) ||
+        !parse_int(args[2], stones)) {
+      out = "syntax error";
+      return false;
+    }
+    clocks_[*color == Color::Black ? 0 : 1] = {seconds, stones};
+  } else if (command == "dg-phase") {
+    const Board &b = board();
+    if (b.game_over())
+      out = "over";
+    else
+      out = std::string(b.to_play() == Color::Black ? "black " : "white ") +
+            phase_name(b.phase());
+  } else {
+    out = "unknown command";
+    return false;
+  }
+  return true;
+}
+
+bool GtpEngine::play(const std::vector<std::string> &args, std::string &out) {
+  if (args.size() != 2) {
+    out = "expected 2 arguments";
+    return false;
+  }
+  auto color = parse_color(args[0]);
+  auto action = parse_vertex(args[1], config_.board_size);
+  if (!color || !action) {
+    out = "syntax error";
+    return false;
+  }
+  const Board &b = board();
+  if (b.game_over() || *color != b.to_play()) {
+    out = "illegal move";
+    return false;
+  }
+  const auto &positions = b.position_history();
+  size_t mark = positions ? positions->mark() : 0;
+  Board next = b;
+  if (!next.apply(*action)) {
+    out = "illegal move";
+    return false;
+  }
+  history_.push_back(std::move(next));
+  superko_marks_.push_back(mark);
+  return true;
+}
+
+bool GtpEngine::genmove(const std::vector<std::string> &args, bool whole_turn,
+                        std::string &out) {
+  if (args.size() != 1) {
+    out = "expected 1 argument";
+    return false;
+  }
+  auto color = parse_color(args[0]);
+  if (!color) {
+    out = "syntax error";
+    return false;
+  }
+  if (board().game_over()) {
+    out = "pass";
+    return true;
+  }
+  if (*color != board().to_play()) {
+    out = std::string("not ") + (*color == Color::Black ? "black" : "white") +
+          "'s turn";
+    return false;
+  }
+
+  do {
+    auto start = std::chrono::steady_clock::now();
+    Action a = think();
+    if (!time_control_.unlimited()) {
+      ClockState &clock = clocks_[*color == Color::Black ? 0 : 1];
+      clock = charge(clock, time_control_,
+                     std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count());
+    }
+    const auto &positions = board().position_history();
+    size_t mark = positions ? positions->mark() : 0;
+    Board next = board();
+    if (!next.apply(a)) {
+      a = Action::pass();
+      next.apply(a);
+    }
+    history_.push_back(std::move(next));
+    superko_marks_.push_back(mark);
+    out += (out.empty() ? "" : " ") + format_vertex(a, config_.board_size);
+  } while (whole_turn && !board().game_over() && board().to_play() == *color);
+  return true;
+}
+
+Action GtpEngine::think() {
+  if (!bot_) {
+    SearchConfig search = config_.search;
+    search.komi = config_.komi;
+    bot_ = std::make_unique<MctsBot>(
+        std::make_shared<RolloutEvaluator>(config_.weights, config_.komi,
+                                           next_seed_++),
+        search);
+  }
+  auto start = std::chrono::steady_clock::now();
+  if (time_control_.unlimited()) {
+    bot_->set_stop_check(nullptr);
+    std::optional<SearchDeadline> deadline;
+    if (config_.move_time > 0)
+      deadline =
+          start +
+          std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+              std::chrono::duration<double>(config_.move_time));
+    return bot_->pick_action(history_, deadline);
+  }
+
+  const Board &b = board();
+  TimeBudget budget = time_manager_.allocate(
+      b, time_control_, clocks_[b.to_play() == Color::Black ? 0 : 1]);
+  time_manager_.start(budget);
+  bot_->set_stop_check([this, start](const SearchProgress &p) {
+    return time_manager_.should_stop(
+        p, std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start)
+               .count());
+  });
+  return bot_->pick_action(history_);
+}
+
+std::string GtpEngine::showboard() const {
+  const Board &b = board();
+  int size = b.size();
+  std::string header = "   ";
+  for (int col = 0; col < size; col++) {
+    header += format_vertex(Action::place({0, col}), size)[0];
+    header += ' ';
+  }
+  std::string s = "\n" + header + "\n";
+  for (int row = 0; row < size; row++) {
+    char label[16];
+    std::snprintf(label, sizeof(label), "%2d ", size - row);
+    s += label;
+    for (int col = 0; col < size; col++) {
+      Color c = b.at({row, col});
+      s += c == Color::Black ? 'X' : c == Color::White ? 'O' : '.';
+      s += ' ';
+    }
+    s += std::to_string(size - row) + "\n";
+  }
+  s += header + "\n";
+  if (b.game_over())
+    s += "game over";
+  else
+    s += std::string(b.to_play() == Color::Black ? "black" : "white") +
+         " to play, " + phase_name(b.phase()) + " stone";
+  s += " | captures B " + std::to_string(b.captures(Color::Black)) + " W " +
+       std::to_string(b.captures(Color::White));
+  return s;
+}
+
+} // namespace double_go
@@ -0,0 +1,84 @@
+#include "double-go/gtp.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+void usage(const char *prog) {
+  std::fprintf(stderr,
+               "usage: %s [--size N] [--komi X] [--visits N] [--time SECONDS]\n"
+               "          [--macro] [--early-stop] [--weights FILE]\n"
+               "          [--seed N] [--superko positional|situational]\n"
+               "Speaks GTP on stdin and stdout. genmove searches with\n"
+               "rollout evaluations for up to --visits simulations or --time\n"
+               "seconds (0: no limit) per stone, or as the clock allows once\n"
+               "the controller sends time_settings.\n",
+               prog);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  double_go::GtpConfig config;
+  config.search.visits = 100000;
+  std::string weights_path;
+
+  for (int i = 1; i < argc; ++i) {
+    auto flag = [&](const char *name) {
+      return std::strcmp(argv[i], name) == 0 && i + 1 < argc;
+    };
+    if (flag("--size")) {
+      config.board_size = std::atoi(argv[++i]);
+    } else if (flag("--komi")) {
+      config.komi = std::atof(argv[++i]);
+    } else if (flag("--visits")) {
+      config.search.visits = std::atoi(argv[++i]);
+    } else if (flag("--time")) {
+      config.move_time = std::atof(argv[++i]);
+    } else if (std::strcmp(argv[i], "--macro") == 0) {
+      config.search.macro_actions = true;
+    } else if (std::strcmp(argv[i], "--early-stop") == 0) {
+      config.search.early_stop = true;
+    } else if (flag("--weights")) {
+      weights_path = argv[++i];
+    } else if (flag("--seed")) {
+      config.seed = static_cast<unsigned>(std::atoll(argv[++i]));
+    } else if (flag("--superko")) {
+      std::string rule = argv[++i];
+      if (rule == "positional") {
+        config.superko = double_go::SuperkoRule::Positional;
+      } else if (rule == "situational") {
+        config.superko = double_go::SuperkoRule::Situational;
+      } else {
+        usage(argv[0]);
+        return 1;
+      }
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+  if (config.board_size < 2 || config.board_size > 19) {
+    usage(argv[0]);
+    return 1;
+  }
+  if (!weights_path.empty()) {
+    try {
+      config.weights = std::make_shared<const double_go::RolloutWeights>(
+          double_go::RolloutWeights::load(weights_path));
+    } catch (const std::runtime_error &e) {
+      std::fprintf(stderr, "%s\n", e.what());
+      return 1;
+    }
+  }
+
+  double_go::GtpEngine engine(config);
+  engine.run(std::cin, std::cout);
+  return 0;
+}
@@ -1,6 +1,76 @@
 #include "gui_common.h"
 
-int main(int /*argc*/, char * /*argv*/[]) {
+#include "double-go/record.h"
+#include "double-go/sgf.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+void usage(const char *prog) {
+  std::fprintf(stderr,
+               "usage: %s [--size N]\n"
+               "       %s --replay FILE [--game N]\n"
+               "Replay keys: Left/Right step, PageUp/PageDown step 10,\n"
+               "Home/End, [ and ] switch games; drag the bar to seek.\n"
+               "FILE is SGF if its name ends in .sgf, else a record file.\n",
+               prog, prog);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  int board_size = 9;
+  std::string replay_path;
+  int replay_game = 1;
+  for (int i = 1; i < argc; ++i) {
+    auto flag = [&](const char *name) {
+      return std::strcmp(argv[i], name) == 0 && i + 1 < argc;
+    };
+    if (flag("--size")) {
+      board_size = std::atoi(argv[++i]);
+    } else if (flag("--replay")) {
+      replay_path = argv[++i];
+    } else if (flag("--game")) {
+      replay_game = std::atoi(argv[++i]);
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  std::vector<double_go::GameRecord> records;
+  if (!replay_path.empty()) {
+    try {
+      records = replay_path.ends_with(".sgf")
+                    ? double_go::load_sgf(replay_path)
+                    : double_go::load_records(replay_path);
+    } catch (const std::runtime_error &e) {
+      std::fprintf(stderr, "%s\n", e.what());
+      return 1;
+    }
+    if (records.empty()) {
+      std::fprintf(stderr, "%s: no games\n", replay_path.c_str());
+      return 1;
+    }
+    replay_game = std::clamp(replay_game, 1, static_cast<int>(records.size()));
+    board_size = records[replay_game - 1].board_size();
+  }
+  bool replay = !records.empty();
+  if (board_size < MIN_BOARD_SIZE || board_size > MAX_BOARD_SIZE) {
+    std::fprintf(stderr, "board size must be %d to %d\n", MIN_BOARD_SIZE,
+                 MAX_BOARD_SIZE);
+    return 1;
+  }
+  Layout layout = Layout::initial(board_size);
+
   if (SDL_Init(SDL_INIT_VIDEO) != 0) {
     SDL_Log("SDL_Init failed: %s", SDL_GetError());
     return 1;
@@ -8,15 +78,19 @@ int main(int /*argc*/, char * /*argv*/[]) {
 
   SDL_Window *window =
       SDL_CreateWindow("Double Go", SDL_WINDOWPOS_CENTERED,
-                       SDL_WINDOWPOS_CENTERED, WIN_W, WIN_H, SDL_WINDOW_SHOWN);
+                       SDL_WINDOWPOS_CENTERED, layout.width, layout.height,
+                       SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
   if (!window) {
     SDL_Log("SDL_CreateWindow failed: %s", SDL_GetError());
     SDL_Quit();
     return 1;
   }
+  SDL_SetWindowMinimumSize(window, 320, 400);
 
   SDL_Renderer *renderer = SDL_CreateRenderer(
-      window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+      window, -1,
+      SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC |
+          SDL_RENDERER_TARGETTEXTURE);
   if (!renderer) {
     SDL_Log("SDL_CreateRenderer failed: %s", SDL_GetError());
     SDL_DestroyWindow(window);
@@ -24,13 +98,51 @@ int main(int /*argc*/, char * /*argv*/[]) {
     return 1;
   }
 
+  if (!SDL_RenderTargetSupported(renderer)) {
+    SDL_Log("renderer does not support render targets");
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+    return 1;
+  }
+
   SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+  auto view = std::make_unique<BoardRenderer>(renderer, layout);
 
-  double_go::Board board(BOARD_SIZE);
+  double_go::Board board(board_size);
   std::optional<double_go::Point> last_move;
   std::optional<double_go::Point> hover_point;
   double komi = 6.5;
 
+  // Replay state: the game shown, its position, and whether the seek bar
+  // is being dragged.
+  int game = replay_game - 1;
+  int move = 0;
+  bool scrubbing = false;
+  auto show = [&](int g, int m) {
+    game = std::clamp(g, 0, static_cast<int>(records.size()) - 1);
+    const auto &record = records[game];
+    move = std::clamp(m, 0, record.num_moves());
+    board = record.position(move);
+    komi = record.komi();
+    last_move.reset();
+    if (move > 0 &&
+        record.actions()[move - 1].type == double_go::ActionType::Place)
+      last_move = record.actions()[move - 1].point;
+    if (record.board_size() != board_size) {
+      board_size = record.board_size();
+      const Layout &l = view->layout();
+      view->set_layout(Layout::fit(board_size, l.width, l.height));
+    }
+  };
+  auto seek_to_pixel = [&](int x) {
+    SDL_Rect bar = view->layout().seek_bar();
+    int n = records[game].num_moves();
+    show(game, (2 * (x - bar.x) * n + bar.w) / (2 * bar.w));
+  };
+  if (replay)
+    show(game, 0);
+
   bool running = true;
   while (running) {
     SDL_Event event;
@@ -40,16 +152,49 @@ int main(int /*argc*/, char * /*argv*/[]) {
         running = false;
         break;
 
+      case SDL_RENDER_TARGETS_RESET:
+      case SDL_RENDER_DEVICE_RESET:
+        view->invalidate();
+        break;
+
+      case SDL_WINDOWEVENT:
+        if (event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+          view->set_layout(Layout::fit(board_size, event.window.data1,
+                                       event.window.data2));
+        break;
+
       case SDL_MOUSEMOTION: {
-        hover_point = pixel_to_point(event.motion.x, event.motion.y);
+        if (replay) {
+          if (scrubbing)
+            seek_to_pixel(event.motion.x);
+          break;
+        }
+        hover_point =
+            view->layout().pixel_to_point(event.motion.x, event.motion.y);
         break;
       }
 
+      case SDL_MOUSEBUTTONUP:
+        scrubbing = false;
+        break;
+
       case SDL_MOUSEBUTTONDOWN: {
+        if (replay) {
+          SDL_Point click{event.button.x, event.button.y};
+          SDL_Rect bar = view->layout().seek_bar();
+          SDL_Rect grab{bar.x, bar.y - 8, bar.w, bar.h + 16};
+          if (event.button.button == SDL_BUTTON_LEFT &&
+              SDL_PointInRect(&click, &grab)) {
+            scrubbing = true;
+            seek_to_pixel(click.x);
+          }
+          break;
+        }
         if (board.game_over())
           break;
 
-        auto pt = pixel_to_point(event.button.x, event.button.y);
+        auto pt =
+            view->layout().pixel_to_point(event.button.x, event.button.y);
         if (!pt)
           break;
 
@@ -66,14 +211,39 @@ int main(int /*argc*/, char * /*argv*/[]) {
         case SDLK_ESCAPE:
           running = false;
           break;
+        case SDLK_LEFT:
+        case SDLK_RIGHT:
+        case SDLK_PAGEUP:
+        case SDLK_PAGEDOWN:
+        case SDLK_HOME:
+        case SDLK_END:
+        case SDLK_LEFTBRACKET:
+        case SDLK_RIGHTBRACKET: {
+          if (!replay)
+            break;
+          SDL_Keycode key = event.key.keysym.sym;
+          if (key == SDLK_LEFT || key == SDLK_RIGHT)
+            show(game, move + (key == SDLK_RIGHT ? 1 : -1));
+          else if (key == SDLK_PAGEUP || key == SDLK_PAGEDOWN)
+            show(game, move + (key == SDLK_PAGEDOWN ? 10 : -10));
+          else if (key == SDLK_HOME || key == SDLK_END)
+            show(game, key == SDLK_END ? records[game].num_moves() : 0);
+          else
+            show(game + (key == SDLK_RIGHTBRACKET ? 1 : -1), 0);
+          break;
+        }
         case SDLK_p:
-          if (!board.game_over()) {
+          if (!replay && !board.game_over()) {
             board.pass();
             last_move = std::nullopt;
           }
           break;
         case SDLK_r:
-          board = double_go::Board(BOARD_SIZE);
+          if (replay) {
+            show(game, 0);
+            break;
+          }
+          board = double_go::Board(board_size);
           last_move = std::nullopt;
           break;
         case SDLK_EQUALS:
@@ -98,10 +268,20 @@ int main(int /*argc*/, char * /*argv*/[]) {
 
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
     SDL_RenderClear(renderer);
-    render_board(renderer, board, last_move, hover_point, komi);
+    view->render(board, last_move, hover_point, komi);
+    if (replay) {
+      char line[64];
+      std::snprintf(line, sizeof(line), "Game %d/%d  Move %d/%d", game + 1,
+                    static_cast<int>(records.size()), move,
+                    records[game].num_moves());
+      view->draw_text(8, view->layout().board_area_height() + 48, line,
+                      STATUS_TEXT);
+      view->draw_seek_bar(move, records[game].num_moves());
+    }
     SDL_RenderPresent(renderer);
   }
 
+  view.reset();
   SDL_DestroyRenderer(renderer);
   SDL_DestroyWindow(window);
   SDL_Quit();
@@ -1,5 +1,6 @@
 #include "gui_common.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <cstdio>
@@ -7,7 +8,8 @@
 
 // ── Bitmap font (5x7, ASCII 32–126) ────────────────────────────────────────
 // Each glyph is 7 bytes (rows top→bottom), each byte's bits 4..0 = columns
-// left→right.  Rendered scaled 2× → 10×14 pixels per character.
+// left→right.  Packed into a texture atlas and drawn scaled 2× → 10×14
+// pixels per character.
 
 static const uint8_t FONT_GLYPHS[][7] = {
     // 32 ' '
@@ -202,41 +204,34 @@ static const uint8_t FONT_GLYPHS[][7] = {
     {0x00, 0x00, 0x08, 0x15, 0x02, 0x00, 0x00},
 };
 
-// ── Star point positions for 9x9 ───────────────────────────────────────────
+// ── Star point positions ────────────────────────────────────────────────────
 
 static const double_go::Point HOSHI_9[] = {
     {2, 2}, {2, 6}, {4, 4}, {6, 2}, {6, 6},
 };
-static constexpr int HOSHI_9_COUNT = 5;
-
-// ── Text rendering ──────────────────────────────────────────────────────────
+static const double_go::Point HOSHI_13[] = {
+    {3, 3}, {3, 9}, {6, 6}, {9, 3}, {9, 9},
+};
+static const double_go::Point HOSHI_19[] = {
+    {3, 3}, {3, 9},  {3, 15},  {9, 3},  {9, 9},
+    {9, 15}, {15, 3}, {15, 9}, {15, 15},
+};
 
-void draw_text(SDL_Renderer *renderer, int x, int y, const char *text,
-               int scale) {
-  const int glyph_w = 5 * scale;
-  const int glyph_h = 7 * scale;
-  int cx = x;
-  for (const char *p = text; *p; ++p) {
-    int ch = static_cast<unsigned char>(*p);
-    if (ch < 32 || ch > 126) {
-      cx += glyph_w + scale;
-      continue;
-    }
-    const uint8_t *glyph = FONT_GLYPHS[ch - 32];
-    for (int row = 0; row < 7; ++row) {
-      uint8_t bits = glyph[row];
-      for (int col = 0; col < 5; ++col) {
-        if (bits & (0x10 >> col)) {
-          SDL_Rect r{cx + col * scale, y + row * scale, scale, scale};
-          SDL_RenderFillRect(renderer, &r);
-        }
-      }
-    }
-    cx += glyph_w + scale;
+std::span<const double_go::Point> hoshi_points(int board_size) {
+  switch (board_size) {
+  case 9:
+    return HOSHI_9;
+  case 13:
+    return HOSHI_13;
+  case 19:
+    return HOSHI_19;
+  default:
+    return {};
   }
-  (void)glyph_h;
 }
 
+// ── Text metrics ────────────────────────────────────────────────────────────
+
 int text_width(const char *text, int scale) {
   int len = static_cast<int>(std::strlen(text));
   if (len == 0)
@@ -274,19 +269,55 @@ void draw_circle_outline(SDL_Renderer *renderer, int cx, int cy, int r) {
   }
 }
 
-// ── Coordinate conversion ───────────────────────────────────────────────────
+static void set_draw_color(SDL_Renderer *renderer, SDL_Color c,
+                           Uint8 alpha = 255) {
+  SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, alpha);
+}
 
-int board_x(int col) { return MARGIN + col * CELL_SIZE; }
-int board_y(int row) { return MARGIN + row * CELL_SIZE; }
+// A stone as the GUI draws it: filled, and outlined if white.
+static void draw_stone_shape(SDL_Renderer *renderer, double_go::Color color,
+                             int cx, int cy, int r) {
+  if (color == double_go::Color::Black) {
+    set_draw_color(renderer, BLACK_STONE);
+    draw_filled_circle(renderer, cx, cy, r);
+  } else {
+    set_draw_color(renderer, WHITE_STONE);
+    draw_filled_circle(renderer, cx, cy, r);
+    set_draw_color(renderer, BLACK_STONE);
+    draw_circle_outline(renderer, cx, cy, r);
+  }
+}
+
+// ── Layout ──────────────────────────────────────────────────────────────────
+
+Layout Layout::fit(int board_size, int width, int height) {
+  Layout l;
+  l.board_size = board_size;
+  l.width = width;
+  l.height = height;
+  int room = std::min(width, height - STATUS_HEIGHT) - 2 * MARGIN;
+  l.cell = std::max(8, room / std::max(1, board_size - 1));
+  int board_px = l.cell * (board_size - 1);
+  l.origin_x = (width - board_px) / 2;
+  l.origin_y = (height - STATUS_HEIGHT - board_px) / 2;
+  l.stone_radius = l.cell / 2 - std::max(1, l.cell / 22);
+  return l;
+}
 
-std::optional<double_go::Point> pixel_to_point(int px, int py) {
-  int col = std::round(static_cast<double>(px - MARGIN) / CELL_SIZE);
-  int row = std::round(static_cast<double>(py - MARGIN) / CELL_SIZE);
-  if (col < 0 || col >= BOARD_SIZE || row < 0 || row >= BOARD_SIZE)
+Layout Layout::initial(int board_size) {
+  int cell = std::max(36, 544 / std::max(1, board_size - 1));
+  int side = cell * (board_size - 1) + 2 * MARGIN;
+  return fit(board_size, side, side + STATUS_HEIGHT);
+}
+
+std::optional<double_go::Point> Layout::pixel_to_point(int px, int py) const {
+  int col = std::round(static_cast<double>(px - origin_x) / cell);
+  int row = std::round(static_cast<double>(py - origin_y) / cell);
+  if (col < 0 || col >= board_size || row < 0 || row >= board_size)
     return std::nullopt;
-  int dx = px - board_x(col);
-  int dy = py - board_y(row);
-  if (dx * dx + dy * dy > STONE_RADIUS * STONE_RADIUS)
+  int dx = px - x(col);
+  int dy = py - y(row);
+  if (dx * dx + dy * dy > stone_radius * stone_radius)
     return std::nullopt;
   return double_go::Point{row, col};
 }
@@ -301,108 +332,216 @@ std::string format_score(double v) {
   return buf;
 }
 
-// ── Board rendering ─────────────────────────────────────────────────────────
-
-void render_board(SDL_Renderer *renderer, const double_go::Board &board,
-                  std::optional<double_go::Point> last_move,
-                  std::optional<double_go::Point> hover, double komi) {
-  // Background
-  SDL_SetRenderDrawColor(renderer, BG_COLOR.r, BG_COLOR.g, BG_COLOR.b, 255);
-  SDL_Rect board_rect{0, 0, WIN_W, WIN_H - STATUS_HEIGHT};
-  SDL_RenderFillRect(renderer, &board_rect);
-
-  // Grid lines
-  SDL_SetRenderDrawColor(renderer, LINE_COLOR.r, LINE_COLOR.g, LINE_COLOR.b,
-                         255);
-  for (int i = 0; i < BOARD_SIZE; ++i) {
-    SDL_RenderDrawLine(renderer, board_x(0), board_y(i),
-                       board_x(BOARD_SIZE - 1), board_y(i));
-    SDL_RenderDrawLine(renderer, board_x(i), board_y(0), board_x(i),
-                       board_y(BOARD_SIZE - 1));
-  }
+// ── BoardRenderer ───────────────────────────────────────────────────────────
+
+static constexpr int GLYPH_COUNT = 126 - 32 + 1;
+static constexpr int PV_SHOWN = 8;
+
+BoardRenderer::BoardRenderer(SDL_Renderer *renderer, const Layout &layout)
+    : renderer_(renderer), layout_(layout) {}
 
-  // Star points (hoshi)
-  for (int i = 0; i < HOSHI_9_COUNT; ++i) {
-    int cx = board_x(HOSHI_9[i].col);
-    int cy = board_y(HOSHI_9[i].row);
-    draw_filled_circle(renderer, cx, cy, 4);
+void BoardRenderer::set_layout(const Layout &layout) {
+  if (layout == layout_)
+    return;
+  layout_ = layout;
+  invalidate();
+}
+
+// The square around an intersection that its stone and markers stay in.
+// Neighbouring cells do not overlap, so one can be redrawn on its own.
+SDL_Rect BoardRenderer::cell_rect(int row, int col) const {
+  return {layout_.x(col) - layout_.cell / 2, layout_.y(row) - layout_.cell / 2,
+          layout_.cell, layout_.cell};
+}
+
+BoardRenderer::~BoardRenderer() { release(); }
+
+void BoardRenderer::invalidate() {
+  release();
+  layer_valid_ = false;
+  status_valid_ = false;
+}
+
+void BoardRenderer::release() {
+  for (SDL_Texture **t :
+       {&empty_board_, &board_layer_, &status_, &stones_[0], &stones_[1],
+        &font_}) {
+    if (*t)
+      SDL_DestroyTexture(*t);
+    *t = nullptr;
   }
+  ready_ = false;
+}
 
-  // Ko point marker
-  auto ko = board.ko_point();
-  if (ko) {
-    SDL_SetRenderDrawColor(renderer, 0xCC, 0x22, 0x22, 255);
-    int cx = board_x(ko->col);
-    int cy = board_y(ko->row);
-    SDL_Rect kr{cx - 4, cy - 4, 9, 9};
-    SDL_RenderFillRect(renderer, &kr);
+static SDL_Texture *make_target(SDL_Renderer *renderer, int w, int h) {
+  SDL_Texture *t = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+                                     SDL_TEXTUREACCESS_TARGET, w, h);
+  if (t)
+    SDL_SetTextureBlendMode(t, SDL_BLENDMODE_BLEND);
+  return t;
+}
+
+bool BoardRenderer::build() {
+  const Layout &l = layout_;
+  int sprite = 2 * l.stone_radius + 1;
+  empty_board_ = make_target(renderer_, l.width, l.board_area_height());
+  board_layer_ = make_target(renderer_, l.width, l.board_area_height());
+  status_ = make_target(renderer_, l.width, STATUS_HEIGHT);
+  stones_[0] = make_target(renderer_, sprite, sprite);
+  stones_[1] = make_target(renderer_, sprite, sprite);
+
+  // Glyph atlas: one 5x7 cell per printable character, white on
+  // transparent, tinted per draw with the color mod.
+  SDL_Surface *glyphs = SDL_CreateRGBSurfaceWithFormat(
+      0, GLYPH_COUNT * 5, 7, 32, SDL_PIXELFORMAT_RGBA32);
+  if (glyphs) {
+    Uint32 on = SDL_MapRGBA(glyphs->format, 255, 255, 255, 255);
+    Uint32 off = SDL_MapRGBA(glyphs->format, 255, 255, 255, 0);
+    auto *pixels = static_cast<Uint32 *>(glyphs->pixels);
+    int stride = glyphs->pitch / 4;
+    for (int g = 0; g < GLYPH_COUNT; ++g)
+      for (int row = 0; row < 7; ++row)
+        for (int col = 0; col < 5; ++col)
+          pixels[row * stride + g * 5 + col] =
+              FONT_GLYPHS[g][row] & (0x10 >> col) ? on : off;
+    font_ = SDL_CreateTextureFromSurface(renderer_, glyphs);
+    SDL_FreeSurface(glyphs);
+  }
+  if (!empty_board_ || !board_layer_ || !status_ || !stones_[0] ||
+      !stones_[1] || !font_) {
+    SDL_Log("BoardRenderer: texture creation failed: %s", SDL_GetError());
+    release();
+    return false;
   }
+  SDL_SetTextureBlendMode(font_, SDL_BLENDMODE_BLEND);
+
+  // Empty board: background, grid lines and star points.
+  SDL_SetRenderTarget(renderer_, empty_board_);
+  set_draw_color(renderer_, BG_COLOR);
+  SDL_RenderClear(renderer_);
+  set_draw_color(renderer_, LINE_COLOR);
+  int last = l.board_size - 1;
+  for (int i = 0; i <= last; ++i) {
+    SDL_RenderDrawLine(renderer_, l.x(0), l.y(i), l.x(last), l.y(i));
+    SDL_RenderDrawLine(renderer_, l.x(i), l.y(0), l.x(i), l.y(last));
+  }
+  for (double_go::Point p : hoshi_points(l.board_size))
+    draw_filled_circle(renderer_, l.x(p.col), l.y(p.row),
+                       std::max(2, l.cell / 17));
+
+  // Stone sprites, on transparent backgrounds.
+  for (int i = 0; i < 2; ++i) {
+    SDL_SetRenderTarget(renderer_, stones_[i]);
+    SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 0);
+    SDL_RenderClear(renderer_);
+    draw_stone_shape(renderer_,
+                     i == 0 ? double_go::Color::Black : double_go::Color::White,
+                     l.stone_radius, l.stone_radius, l.stone_radius);
+  }
+  SDL_SetRenderTarget(renderer_, nullptr);
+  ready_ = true;
+  return true;
+}
 
-  // Stones
-  for (int r = 0; r < BOARD_SIZE; ++r) {
-    for (int c = 0; c < BOARD_SIZE; ++c) {
-      auto color = board.at({r, c});
-      if (color == double_go::Color::Empty)
-        continue;
-      int cx = board_x(c);
-      int cy = board_y(r);
-      if (color == double_go::Color::Black) {
-        SDL_SetRenderDrawColor(renderer, BLACK_STONE.r, BLACK_STONE.g,
-                               BLACK_STONE.b, 255);
-        draw_filled_circle(renderer, cx, cy, STONE_RADIUS);
-      } else {
-        SDL_SetRenderDrawColor(renderer, WHITE_STONE.r, WHITE_STONE.g,
-                               WHITE_STONE.b, 255);
-        draw_filled_circle(renderer, cx, cy, STONE_RADIUS);
-        SDL_SetRenderDrawColor(renderer, BLACK_STONE.r, BLACK_STONE.g,
-                               BLACK_STONE.b, 255);
-        draw_circle_outline(renderer, cx, cy, STONE_RADIUS);
-      }
+void BoardRenderer::draw_text(int x, int y, const char *text, SDL_Color color,
+                              int scale) {
+  SDL_SetTextureColorMod(font_, color.r, color.g, color.b);
+  int cx = x;
+  for (const char *p = text; *p; ++p) {
+    int ch = static_cast<unsigned char>(*p);
+    if (ch >= 32 && ch <= 126) {
+      SDL_Rect src{(ch - 32) * 5, 0, 5, 7};
+      SDL_Rect dst{cx, y, 5 * scale, 7 * scale};
+      SDL_RenderCopy(renderer_, font_, &src, &dst);
     }
+    cx += 5 * scale + scale;
   }
+}
 
-  // Last move marker
-  if (last_move) {
-    auto color = board.at(*last_move);
-    int cx = board_x(last_move->col);
-    int cy = board_y(last_move->row);
-    if (color == double_go::Color::Black) {
-      SDL_SetRenderDrawColor(renderer, WHITE_STONE.r, WHITE_STONE.g,
-                             WHITE_STONE.b, 255);
-    } else {
-      SDL_SetRenderDrawColor(renderer, BLACK_STONE.r, BLACK_STONE.g,
-                             BLACK_STONE.b, 255);
-    }
-    draw_filled_circle(renderer, cx, cy, 5);
+void BoardRenderer::draw_stone(double_go::Color color, int cx, int cy,
+                               Uint8 alpha) {
+  SDL_Texture *sprite = stones_[color == double_go::Color::Black ? 0 : 1];
+  SDL_SetTextureAlphaMod(sprite, alpha);
+  int r = layout_.stone_radius;
+  SDL_Rect dst{cx - r, cy - r, 2 * r + 1, 2 * r + 1};
+  SDL_RenderCopy(renderer_, sprite, nullptr, &dst);
+}
+
+void BoardRenderer::draw_cell(const double_go::Board &board, int idx,
+                              std::optional<double_go::Point> last_move) {
+  int n = layout_.board_size;
+  double_go::Point p{idx / n, idx % n};
+  int cx = layout_.x(p.col);
+  int cy = layout_.y(p.row);
+  SDL_Rect cell = cell_rect(p.row, p.col);
+  SDL_RenderCopy(renderer_, empty_board_, &cell, &cell);
+
+  if (board.ko_point() == p) {
+    SDL_SetRenderDrawColor(renderer_, 0xCC, 0x22, 0x22, 255);
+    int k = std::max(2, layout_.cell / 16);
+    SDL_Rect kr{cx - k, cy - k, 2 * k + 1, 2 * k + 1};
+    SDL_RenderFillRect(renderer_, &kr);
+  }
+  auto color = board.at(p);
+  if (color != double_go::Color::Empty)
+    draw_stone(color, cx, cy, 255);
+  if (last_move == p) {
+    set_draw_color(renderer_, color == double_go::Color::Black ? WHITE_STONE
+                                                              : BLACK_STONE);
+    draw_filled_circle(renderer_, cx, cy, std::max(2, layout_.cell / 13));
   }
+}
 
-  // Hover preview (semi-transparent stone)
-  if (!board.game_over() && hover &&
-      board.at(*hover) == double_go::Color::Empty && board.is_legal(*hover)) {
-    int cx = board_x(hover->col);
-    int cy = board_y(hover->row);
-    if (board.to_play() == double_go::Color::Black) {
-      SDL_SetRenderDrawColor(renderer, BLACK_STONE.r, BLACK_STONE.g,
-                             BLACK_STONE.b, 100);
-    } else {
-      SDL_SetRenderDrawColor(renderer, WHITE_STONE.r, WHITE_STONE.g,
-                             WHITE_STONE.b, 100);
-    }
-    draw_filled_circle(renderer, cx, cy, STONE_RADIUS);
-    if (board.to_play() == double_go::Color::White) {
-      SDL_SetRenderDrawColor(renderer, BLACK_STONE.r, BLACK_STONE.g,
-                             BLACK_STONE.b, 100);
-      draw_circle_outline(renderer, cx, cy, STONE_RADIUS);
-    }
+void BoardRenderer::update_board_layer(
+    const double_go::Board &board, std::optional<double_go::Point> last_move) {
+  if (layer_valid_ && board.hash() == drawn_hash_ && last_move == drawn_last_)
+    return;
+
+  SDL_SetRenderTarget(renderer_, board_layer_);
+  if (!layer_valid_) {
+    SDL_RenderCopy(renderer_, empty_board_, nullptr, nullptr);
+    drawn_grid_.assign(layout_.board_size * layout_.board_size,
+                       double_go::Color::Empty);
+    drawn_ko_.reset();
+    drawn_last_.reset();
   }
 
-  // ── Status bar ──────────────────────────────────────────────────────────
-  SDL_SetRenderDrawColor(renderer, STATUS_BG.r, STATUS_BG.g, STATUS_BG.b, 255);
-  SDL_Rect status_rect{0, WIN_H - STATUS_HEIGHT, WIN_W, STATUS_HEIGHT};
-  SDL_RenderFillRect(renderer, &status_rect);
+  // Redraw only the cells whose contents changed: stones placed or
+  // captured, and the old and new ko and last-move markers.
+  std::vector<bool> dirty(drawn_grid_.size(), false);
+  for (size_t i = 0; i < dirty.size(); ++i)
+    dirty[i] = drawn_grid_[i] != board.at_index(static_cast<int>(i));
+  for (auto p : {drawn_ko_, board.ko_point(), drawn_last_, last_move})
+    if (p)
+      dirty[p->row * layout_.board_size + p->col] = true;
+  for (size_t i = 0; i < dirty.size(); ++i) {
+    if (!dirty[i])
+      continue;
+    draw_cell(board, static_cast<int>(i), last_move);
+    drawn_grid_[i] = board.at_index(static_cast<int>(i));
+  }
+  SDL_SetRenderTarget(renderer_, nullptr);
 
-  auto sr = board.score(komi);
-  int line1_y = WIN_H - STATUS_HEIGHT + 8;
+  drawn_hash_ = board.hash();
+  drawn_ko_ = board.ko_point();
+  drawn_last_ = last_move;
+  layer_valid_ = true;
+}
+
+void BoardRenderer::update_status(const double_go::Board &board, double komi,
+                                  const double_go::ScoreResult *score) {
+  StatusKey key{board.hash(), board.captures(double_go::Color::Black),
+                board.captures(double_go::Color::White),
+                board.consecutive_passes(), komi};
+  if (status_valid_ && key == drawn_status_)
+    return;
+
+  SDL_SetRenderTarget(renderer_, status_);
+  set_draw_color(renderer_, STATUS_BG);
+  SDL_RenderClear(renderer_);
+
+  auto sr = score ? *score : board.score(komi);
+  int line1_y = 8;
   int line2_y = line1_y + 20;
 
   if (board.game_over()) {
@@ -416,51 +555,135 @@ void render_board(SDL_Renderer *renderer, const double_go::Board &board,
 
     std::string line1 = "GAME OVER | B:" + format_score(sr.black_score) +
                         " W:" + format_score(sr.white_score) + " | " + winner;
-
-    SDL_SetRenderDrawColor(renderer, STATUS_TEXT.r, STATUS_TEXT.g,
-                           STATUS_TEXT.b, 255);
-    draw_text(renderer, 8, line1_y, line1.c_str());
-
-    std::string line2 = "R:reset  Q:quit";
-    draw_text(renderer, 8, line2_y, line2.c_str());
+    draw_text(8, line1_y, line1.c_str(), STATUS_TEXT);
+    draw_text(8, line2_y, "R:reset  Q:quit", STATUS_TEXT);
   } else {
     // Player indicator circle
-    int indicator_cx = 24;
-    int indicator_cy = line1_y + 7;
-    int indicator_r = 7;
-    if (board.to_play() == double_go::Color::Black) {
-      SDL_SetRenderDrawColor(renderer, BLACK_STONE.r, BLACK_STONE.g,
-                             BLACK_STONE.b, 255);
-      draw_filled_circle(renderer, indicator_cx, indicator_cy, indicator_r);
-    } else {
-      SDL_SetRenderDrawColor(renderer, WHITE_STONE.r, WHITE_STONE.g,
-                             WHITE_STONE.b, 255);
-      draw_filled_circle(renderer, indicator_cx, indicator_cy, indicator_r);
-      SDL_SetRenderDrawColor(renderer, BLACK_STONE.r, BLACK_STONE.g,
-                             BLACK_STONE.b, 255);
-      draw_circle_outline(renderer, indicator_cx, indicator_cy, indicator_r);
-    }
+    draw_stone_shape(renderer_, board.to_play(), 24, line1_y + 7, 7);
 
-    std::string status;
     const char *player =
         board.to_play() == double_go::Color::Black ? "BLACK" : "WHITE";
-
-    status = std::string(player) + " to play";
-
-    std::string caps =
+    std::string status =
+        std::string(player) + " to play" +
         " | B:" + std::to_string(board.captures(double_go::Color::Black)) +
         " W:" + std::to_string(board.captures(double_go::Color::White));
-    status += caps;
-
-    SDL_SetRenderDrawColor(renderer, STATUS_TEXT.r, STATUS_TEXT.g,
-                           STATUS_TEXT.b, 255);
-    draw_text(renderer, 44, line1_y, status.c_str());
+    draw_text(44, line1_y, status.c_str(), STATUS_TEXT);
 
     std::string score_line =
         "B:" + std::to_string(sr.black_stones + sr.black_territory) +
         " W:" + std::to_string(sr.white_stones + sr.white_territory) + "+" +
         format_score(komi) + "=" + format_score(sr.white_score) +
         "  Komi:" + format_score(komi) + " [+/-]";
-    draw_text(renderer, 8, line2_y, score_line.c_str());
+    draw_text(8, line2_y, score_line.c_str(), STATUS_TEXT);
+  }
+  SDL_SetRenderTarget(renderer_, nullptr);
+
+  drawn_status_ = key;
+  status_valid_ = true;
+}
+
+void BoardRenderer::render(const double_go::Board &board,
+                           std::optional<double_go::Point> last_move,
+                           std::optional<double_go::Point> hover, double komi,
+                           const double_go::ScoreResult *score) {
+  if (!ready_ && !build())
+    return;
+  update_board_layer(board, last_move);
+  update_status(board, komi, score);
+
+  SDL_Rect board_rect{0, 0, layout_.width, layout_.board_area_height()};
+  SDL_RenderCopy(renderer_, board_layer_, nullptr, &board_rect);
+
+  // Hover preview (semi-transparent stone)
+  if (!board.game_over() && hover &&
+      board.at(*hover) == double_go::Color::Empty && board.is_legal(*hover))
+    draw_stone(board.to_play(), layout_.x(hover->col), layout_.y(hover->row),
+               100);
+
+  SDL_Rect status_rect{0, layout_.board_area_height(), layout_.width,
+                       STATUS_HEIGHT};
+  SDL_RenderCopy(renderer_, status_, nullptr, &status_rect);
+}
+
+void BoardRenderer::draw_seek_bar(int position, int length) {
+  SDL_Rect bar = layout_.seek_bar();
+  SDL_SetRenderDrawColor(renderer_, 0x50, 0x50, 0x50, 255);
+  SDL_RenderFillRect(renderer_, &bar);
+  if (length <= 0)
+    return;
+  bar.w = static_cast<int>(static_cast<long long>(bar.w) * position / length);
+  set_draw_color(renderer_, STATUS_TEXT);
+  SDL_RenderFillRect(renderer_, &bar);
+}
+
+void BoardRenderer::draw_analysis(const double_go::Board &board,
+                                  const double_go::SearchResult &search,
+                                  Heatmap heatmap) {
+  if (!ready_ || board.game_over() || search.children.empty())
+    return;
+
+  // Heatmap over first stones; a macro-action's second stone only shows in
+  // the principal variation.
+  const Layout &l = layout_;
+  heat_.assign(l.board_size * l.board_size, 0.0f);
+  float max_heat = 0.0f;
+  for (const auto &c : search.children) {
+    if (c.first.type != double_go::ActionType::Place)
+      continue;
+    float &h = heat_[c.first.point.row * l.board_size + c.first.point.col];
+    h += heatmap == Heatmap::Visits ? static_cast<float>(c.visits) : c.prior;
+    max_heat = std::max(max_heat, h);
+  }
+  if (max_heat > 0.0f) {
+    for (size_t i = 0; i < heat_.size(); ++i) {
+      if (heat_[i] <= 0.0f)
+        continue;
+      int cx = l.x(static_cast<int>(i) % l.board_size);
+      int cy = l.y(static_cast<int>(i) / l.board_size);
+      auto alpha = static_cast<Uint8>(40 + 150 * heat_[i] / max_heat);
+      set_draw_color(renderer_, HEAT_COLOR, alpha);
+      SDL_Rect r{cx - l.cell / 2 + 2, cy - l.cell / 2 + 2, l.cell - 4,
+                 l.cell - 4};
+      SDL_RenderFillRect(renderer_, &r);
+
+      char label[16];
+      if (heatmap == Heatmap::Visits)
+        std::snprintf(label, sizeof(label), "%d", static_cast<int>(heat_[i]));
+      else
+        std::snprintf(label, sizeof(label), "%.0f%%", 100.0f * heat_[i]);
+      draw_text(cx - text_width(label, 1) / 2, cy + l.cell / 2 - 11, label,
+                WHITE_STONE, 1);
+    }
+  }
+
+  // Principal variation, replayed on a copy for the movers' colors. Passes
+  // keep their number but are not drawn.
+  const auto &positions = board.position_history();
+  size_t mark = positions ? positions->mark() : 0;
+  double_go::Board line = board;
+  for (int move = 1;
+       move <= PV_SHOWN && move <= static_cast<int>(search.pv.size()); ++move) {
+    double_go::Action a = search.pv[move - 1];
+    double_go::Color mover = line.to_play();
+    if (!line.apply(a))
+      break;
+    if (a.type != double_go::ActionType::Place)
+      continue;
+    int cx = l.x(a.point.col);
+    int cy = l.y(a.point.row);
+    draw_stone(mover, cx, cy, 170);
+    std::string label = std::to_string(move);
+    draw_text(cx - text_width(label.c_str()) / 2, cy - 7, label.c_str(),
+              mover == double_go::Color::Black ? WHITE_STONE : BLACK_STONE);
   }
+  if (positions)
+    positions->rollback(mark);
+
+  // The value is for the side to move; the status bar shows Black's odds.
+  float black_value =
+      board.to_play() == double_go::Color::Black ? search.value : -search.value;
+  char status[64];
+  std::snprintf(status, sizeof(status), "Search %d visits | Black %.0f%%",
+                search.visits, 50.0f * (black_value + 1.0f));
+  draw_text(8, l.board_area_height() + 48, status, STATUS_TEXT);
 }
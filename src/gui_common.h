@@ -1,21 +1,51 @@
 #pragma once
 
 #include "double-go/double-go.h"
+#include "double-go/search.h"
 
 #include <SDL2/SDL.h>
+#include <cstdint>
 #include <optional>
+#include <span>
 #include <string>
+#include <vector>
 
-// ── Layout constants ────────────────────────────────────────────────────────
+// ── Layout ──────────────────────────────────────────────────────────────────
 
-inline constexpr int BOARD_SIZE = 9;
 inline constexpr int MARGIN = 40;
 inline constexpr int STATUS_HEIGHT = 80;
-inline constexpr int CELL_SIZE = 68;
-inline constexpr int BOARD_PX = CELL_SIZE * (BOARD_SIZE - 1);
-inline constexpr int WIN_W = BOARD_PX + 2 * MARGIN;
-inline constexpr int WIN_H = BOARD_PX + 2 * MARGIN + STATUS_HEIGHT;
-inline constexpr int STONE_RADIUS = CELL_SIZE / 2 - 3;
+inline constexpr int MIN_BOARD_SIZE = 2;
+inline constexpr int MAX_BOARD_SIZE = 19;
+
+// Pixel geometry of a board in a window: the largest square grid that fits
+// above the status bar with at least MARGIN around it, centered.
+struct Layout {
+  int board_size = 9;
+  int width = 0;
+  int height = 0;
+  int cell = 0;
+  int origin_x = 0; // pixel position of point (0, 0)
+  int origin_y = 0;
+  int stone_radius = 0;
+
+  static Layout fit(int board_size, int width, int height);
+  // A comfortable window for the board size, 624x704 for 9x9.
+  static Layout initial(int board_size);
+
+  int board_area_height() const { return height - STATUS_HEIGHT; }
+  int x(int col) const { return origin_x + col * cell; }
+  int y(int row) const { return origin_y + row * cell; }
+  // The point whose stone covers the pixel, if any.
+  std::optional<double_go::Point> pixel_to_point(int px, int py) const;
+  // The replay seek bar, along the bottom of the status bar.
+  SDL_Rect seek_bar() const { return {8, height - 16, width - 16, 8}; }
+
+  bool operator==(const Layout &) const = default;
+};
+
+// Star points of the standard 9x9, 13x13 and 19x19 boards; empty for other
+// sizes.
+std::span<const double_go::Point> hoshi_points(int board_size);
 
 // ── Color constants ─────────────────────────────────────────────────────────
 
@@ -25,18 +55,101 @@ inline constexpr SDL_Color BLACK_STONE{0x20, 0x20, 0x20, 0xFF};
 inline constexpr SDL_Color WHITE_STONE{0xF0, 0xF0, 0xF0, 0xFF};
 inline constexpr SDL_Color STATUS_BG{0x30, 0x30, 0x30, 0xFF};
 inline constexpr SDL_Color STATUS_TEXT{0xE0, 0xE0, 0xE0, 0xFF};
+inline constexpr SDL_Color HEAT_COLOR{0x20, 0x60, 0xE0, 0xFF};
 
 // ── Function declarations ───────────────────────────────────────────────────
 
-void draw_text(SDL_Renderer *renderer, int x, int y, const char *text,
-               int scale = 2);
 int text_width(const char *text, int scale = 2);
 void draw_filled_circle(SDL_Renderer *renderer, int cx, int cy, int r);
 void draw_circle_outline(SDL_Renderer *renderer, int cx, int cy, int r);
-int board_x(int col);
-int board_y(int row);
-std::optional<double_go::Point> pixel_to_point(int px, int py);
 std::string format_score(double v);
-void render_board(SDL_Renderer *renderer, const double_go::Board &board,
-                  std::optional<double_go::Point> last_move,
-                  std::optional<double_go::Point> hover, double komi);
+
+// ── Board rendering ─────────────────────────────────────────────────────────
+
+// What the search overlay shades each intersection by.
+enum class Heatmap { Visits, Priors };
+
+// Draws the board and status bar from cached textures: the empty board and
+// one sprite per stone color are rendered once, and text comes from a glyph
+// atlas. The board with its stones and the status bar live in their own
+// target textures, redrawn only when the position, last move or komi
+// changes, and then only in the cells that changed. A frame is otherwise a
+// few texture copies. The renderer must support render targets.
+class BoardRenderer {
+public:
+  BoardRenderer(SDL_Renderer *renderer, const Layout &layout);
+
+  const Layout &layout() const { return layout_; }
+  // Switches to a new board or window size; textures are rebuilt on the
+  // next render() if it differs.
+  void set_layout(const Layout &layout);
+  ~BoardRenderer();
+  BoardRenderer(const BoardRenderer &) = delete;
+  BoardRenderer &operator=(const BoardRenderer &) = delete;
+
+  // score, if given, is the board's score at this komi, so a caller that
+  // already has it spares the UI thread the work.
+  void render(const double_go::Board &board,
+              std::optional<double_go::Point> last_move,
+              std::optional<double_go::Point> hover, double komi,
+              const double_go::ScoreResult *score = nullptr);
+
+  // Draws a search of board on top of the last render(): every candidate
+  // point shaded by its share of the visits or prior with the figure on it,
+  // the start of the principal variation as numbered stones, and the
+  // search's value on the last status line. Drawn each frame, not cached.
+  void draw_analysis(const double_go::Board &board,
+                     const double_go::SearchResult &search, Heatmap heatmap);
+
+  // Draws Layout::seek_bar() filled to position out of length.
+  void draw_seek_bar(int position, int length);
+
+  // Drops every texture so the next render() rebuilds them. Call on
+  // SDL_RENDER_TARGETS_RESET and SDL_RENDER_DEVICE_RESET, after which
+  // texture contents are lost.
+  void invalidate();
+
+  void draw_text(int x, int y, const char *text, SDL_Color color,
+                 int scale = 2);
+
+private:
+  struct StatusKey {
+    uint64_t hash;
+    int black_captures;
+    int white_captures;
+    int passes;
+    double komi;
+    bool operator==(const StatusKey &) const = default;
+  };
+
+  bool build();
+  void release();
+  void draw_stone(double_go::Color color, int cx, int cy, Uint8 alpha);
+  void draw_cell(const double_go::Board &board, int idx,
+                 std::optional<double_go::Point> last_move);
+  SDL_Rect cell_rect(int row, int col) const;
+  void update_board_layer(const double_go::Board &board,
+                          std::optional<double_go::Point> last_move);
+  void update_status(const double_go::Board &board, double komi,
+                     const double_go::ScoreResult *score);
+
+  SDL_Renderer *renderer_;
+  Layout layout_;
+  bool ready_ = false;
+  SDL_Texture *empty_board_ = nullptr;
+  SDL_Texture *board_layer_ = nullptr;
+  SDL_Texture *status_ = nullptr;
+  SDL_Texture *stones_[2] = {nullptr, nullptr}; // Black, White
+  SDL_Texture *font_ = nullptr;
+
+  // What board_layer_ and status_ currently show.
+  bool layer_valid_ = false;
+  uint64_t drawn_hash_ = 0;
+  std::vector<double_go::Color> drawn_grid_;
+  std::optional<double_go::Point> drawn_ko_;
+  std::optional<double_go::Point> drawn_last_;
+  bool status_valid_ = false;
+  StatusKey drawn_status_{};
+
+  std::vector<float> heat_;
+};
@@ -0,0 +1,285 @@
+#include "double-go/life.h"
+
+#include <algorithm>
+
+namespace double_go {
+
+namespace {
+
+template <typename F> void for_each_neighbor(int idx, int size, F &&f) {
+  int r = idx / size, c = idx % size;
+  if (r > 0)
+    f(idx - size);
+  if (r < size - 1)
+    f(idx + size);
+  if (c > 0)
+    f(idx - 1);
+  if (c < size - 1)
+    f(idx + 1);
+}
+
+// Labels the connected components of the points for which in_set is true.
+// labels[i] is -1 outside the set. Returns the number of components.
+template <typename Pred>
+int label_components(int size, Pred in_set, std::vector<int> &labels) {
+  int total = size * size;
+  labels.assign(total, -1);
+  std::vector<int> stack;
+  int count = 0;
+  for (int i = 0; i < total; i++) {
+    if (labels[i] >= 0 || !in_set(i))
+      continue;
+    labels[i] = count;
+    stack.push_back(i);
+    while (!stack.empty()) {
+      int idx = stack.back();
+      stack.pop_back();
+      for_each_neighbor(idx, size, [&](int ni) {
+        if (labels[ni] < 0 && in_set(ni)) {
+          labels[ni] = count;
+          stack.push_back(ni);
+        }
+      });
+    }
+    count++;
+  }
+  return count;
+}
+
+// Benson's algorithm for one color: marks the pass-alive chains of that
+// color, and the regions they enclose as territory, in owner.
+void benson(const Board &board, Color color, std::vector<Color> &owner) {
+  int size = board.size(), total = size * size;
+  std::vector<int> chain, region;
+  int num_chains = label_components(
+      size, [&](int i) { return board.at_index(i) == color; }, chain);
+  int num_regions = label_components(
+      size, [&](int i) { return board.at_index(i) != color; }, region);
+
+  // A region is healthy for a bordering chain when every empty point in the
+  // region is a liberty of that chain. Count, per region, its empty points
+  // and how many of them each bordering chain touches.
+  struct Border {
+    int chain;
+    int liberties;
+  };
+  std::vector<std::vector<Border>> borders(num_regions);
+  std::vector<int> empties(num_regions, 0);
+  std::vector<int> last_seen(num_chains, -1);
+  for (int i = 0; i < total; i++) {
+    if (board.at_index(i) == color)
+      continue;
+    int r = region[i];
+    bool empty = board.at_index(i) == Color::Empty;
+    empties[r] += empty;
+    for_each_neighbor(i, size, [&](int ni) {
+      int x = chain[ni];
+      if (x < 0 || last_seen[x] == i)
+        return;
+      last_seen[x] = i;
+      auto &list = borders[r];
+      auto it = std::find_if(list.begin(), list.end(),
+                             [&](const Border &b) { return b.chain == x; });
+      if (it == list.end())
+        it = list.insert(list.end(), {x, 0});
+      it->liberties += empty;
+    });
+  }
+
+  // Repeatedly drop chains with fewer than two healthy regions, and regions
+  // bordering a dropped chain, until nothing changes.
+  std::vector<bool> chain_alive(num_chains, true);
+  std::vector<bool> region_alive(num_regions, true);
+  std::vector<int> healthy(num_chains);
+  for (bool changed = true; changed;) {
+    changed = false;
+    std::fill(healthy.begin(), healthy.end(), 0);
+    for (int r = 0; r < num_regions; r++) {
+      if (!region_alive[r])
+        continue;
+      for (const Border &b : borders[r])
+        healthy[b.chain] += b.liberties == empties[r];
+    }
+    for (int x = 0; x < num_chains; x++) {
+      if (chain_alive[x] && healthy[x] < 2) {
+        chain_alive[x] = false;
+        changed = true;
+      }
+    }
+    for (int r = 0; r < num_regions; r++) {
+      for (const Border &b : borders[r])
+        if (!chain_alive[b.chain])
+          region_alive[r] = false;
+    }
+  }
+
+  // Territory: regions enclosed only by pass-alive chains and healthy for
+  // at least one of them. The opponent cannot make a living group in such a
+  // region, so any stones it has there are dead.
+  std::vector<bool> territory(num_regions, false);
+  for (int r = 0; r < num_regions; r++) {
+    if (!region_alive[r] || borders[r].empty())
+      continue;
+    for (const Border &b : borders[r])
+      if (b.liberties == empties[r])
+        territory[r] = true;
+  }
+  for (int i = 0; i < total; i++) {
+    if (chain[i] >= 0 ? chain_alive[chain[i]] : territory[region[i]])
+      owner[i] = color;
+  }
+}
+
+// Area ownership of a position given as a grid: stones own their point,
+// and an empty region belongs to a color when only that color borders it.
+std::vector<Color> area_owners(const std::vector<Color> &grid, int size) {
+  std::vector<Color> owners = grid;
+  std::vector<int> region;
+  int num_regions = label_components(
+      size, [&](int i) { return grid[i] == Color::Empty; }, region);
+  std::vector<uint8_t> colors(num_regions, 0);
+  for (int i = 0; i < size * size; i++) {
+    if (region[i] < 0)
+      continue;
+    for_each_neighbor(i, size, [&](int ni) {
+      if (grid[ni] == Color::Black)
+        colors[region[i]] |= 1;
+      else if (grid[ni] == Color::White)
+        colors[region[i]] |= 2;
+    });
+  }
+  for (int i = 0; i < size * size; i++) {
+    if (region[i] < 0)
+      continue;
+    uint8_t c = colors[region[i]];
+    owners[i] = c == 1 ? Color::Black : c == 2 ? Color::White : Color::Empty;
+  }
+  return owners;
+}
+
+std::vector<Color> board_grid(const Board &board) {
+  std::vector<Color> grid(board.size() * board.size());
+  for (size_t i = 0; i < grid.size(); i++)
+    grid[i] = board.at_index(static_cast<int>(i));
+  return grid;
+}
+
+// Builds a ScoreResult from per-point owners. Stones still on the board
+// that belong to their owner count as stones, everything else owned counts
+// as territory.
+ScoreResult tally(const Board &board, const std::vector<Color> &owners,
+                  double komi) {
+  ScoreResult result{};
+  for (size_t i = 0; i < owners.size(); i++) {
+    bool stone = board.at_index(static_cast<int>(i)) == owners[i];
+    if (owners[i] == Color::Black)
+      ++(stone ? result.black_stones : result.black_territory);
+    else if (owners[i] == Color::White)
+      ++(stone ? result.white_stones : result.white_territory);
+  }
+  result.black_score = result.black_stones + result.black_territory;
+  result.white_score = result.white_stones + result.white_territory + komi;
+  return result;
+}
+
+// A random legal placement that does not fill one of the mover's own
+// single-point eyes, or a pass if there is none.
+Action playout_action(const Board &board, std::mt19937 &rng) {
+  int size = board.size();
+  Color me = board.to_play();
+  auto moves = board.legal_moves();
+  std::erase_if(moves, [&](Point p) {
+    bool eye = true;
+    for_each_neighbor(p.row * size + p.col, size,
+                      [&](int ni) { eye &= board.at_index(ni) == me; });
+    return eye;
+  });
+  if (moves.empty())
+    return Action::pass();
+  std::uniform_int_distribution<size_t> pick(0, moves.size() - 1);
+  return Action::place(moves[pick(rng)]);
+}
+
+} // namespace
+
+// ── Unconditional life ──────────────────────────────────────────────────────
+
+LifeStatus pass_alive(const Board &board) {
+  LifeStatus life;
+  life.owner.assign(board.size() * board.size(), Color::Empty);
+  benson(board, Color::Black, life.owner);
+  benson(board, Color::White, life.owner);
+  for (Color c : life.owner) {
+    life.black_points += c == Color::Black;
+    life.white_points += c == Color::White;
+  }
+  return life;
+}
+
+ScoreResult score_pass_alive(const Board &board, const LifeStatus &life,
+                             double komi) {
+  // Filling pass-alive territory with its owner's stones removes the dead
+  // stones and leaves the scoring of open regions unchanged, since those
+  // regions never border the filled ones.
+  std::vector<Color> grid = board_grid(board);
+  for (size_t i = 0; i < grid.size(); i++)
+    if (life.owner[i] != Color::Empty)
+      grid[i] = life.owner[i];
+  return tally(board, area_owners(grid, board.size()), komi);
+}
+
+std::optional<Color> settled_winner(const LifeStatus &life, double komi) {
+  int total = static_cast<int>(life.owner.size());
+  if (life.black_points > total - life.black_points + komi)
+    return Color::Black;
+  if (life.white_points + komi > total - life.white_points)
+    return Color::White;
+  return std::nullopt;
+}
+
+// ── Dead-stone estimation ───────────────────────────────────────────────────
+
+std::vector<float> estimate_ownership(const Board &board, int playouts,
+                                      std::mt19937 &rng) {
+  int size = board.size();
+  int max_moves = 3 * size * size;
+  std::vector<float> ownership(size * size, 0.0f);
+  if (playouts <= 0)
+    return ownership;
+
+  auto history = board.position_history();
+  for (int n = 0; n < playouts; n++) {
+    size_t mark = history ? history->mark() : 0;
+    Board b = board;
+    for (int m = 0; m < max_moves && !b.game_over(); m++) {
+      if (!b.apply(playout_action(b, rng)))
+        b.apply(Action::pass());
+    }
+    auto owners = area_owners(board_grid(b), size);
+    for (int i = 0; i < size * size; i++) {
+      if (owners[i] == Color::Black)
+        ownership[i] += 1.0f;
+      else if (owners[i] == Color::White)
+        ownership[i] -= 1.0f;
+    }
+    if (history)
+      history->rollback(mark);
+  }
+  for (float &o : ownership)
+    o /= playouts;
+  return ownership;
+}
+
+ScoreResult score_with_dead_stones(const Board &board,
+                                   const std::vector<float> &ownership,
+                                   double komi, float threshold) {
+  std::vector<Color> grid = board_grid(board);
+  for (size_t i = 0; i < grid.size(); i++) {
+    if ((grid[i] == Color::Black && ownership[i] <= -threshold) ||
+        (grid[i] == Color::White && ownership[i] >= threshold))
+      grid[i] = Color::Empty;
+  }
+  return tally(board, area_owners(grid, board.size()), komi);
+}
+
+} // namespace double_go
@@ -0,0 +1,240 @@
+#include "double-go/match.h"
+#include "double-go/life.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace double_go {
+
+GameResult play_game(const Player &black, const Player &white, int board_size,
+                     double komi, int max_moves, SuperkoRule superko,
+                     bool stop_when_settled) {
+  std::deque<Board> history;
+  history.emplace_back(board_size);
+  if (superko != SuperkoRule::None)
+    history.back().enable_superko(superko);
+  int moves = 0;
+  LifeStatus life;
+  bool settled = false;
+  std::vector<Action> actions;
+  while (!history.back().game_over() && !settled && moves < max_moves) {
+    const Board &board = history.back();
+    const Player &player = board.to_play() == Color::Black ? black : white;
+    Action action = player(history);
+    Board next = board;
+    if (!next.apply(action)) {
+      action = Action::pass();
+      next.apply(action);
+    }
+    actions.push_back(action);
+    history.push_back(std::move(next));
+    ++moves;
+    // Checking once per turn is enough; the analysis costs a few floods.
+    if (stop_when_settled && history.back().phase() == Phase::First) {
+      life = pass_alive(history.back());
+      settled = settled_winner(life, komi).has_value();
+    }
+  }
+
+  const Board &final_board = history.back();
+  auto sr = settled ? score_pass_alive(final_board, life, komi)
+                    : final_board.score(komi);
+  GameResult result;
+  result.black_score = sr.black_score;
+  result.white_score = sr.white_score;
+  if (sr.black_score > sr.white_score)
+    result.winner = Color::Black;
+  else if (sr.white_score > sr.black_score)
+    result.winner = Color::White;
+  else
+    result.winner = Color::Empty;
+  result.num_moves = moves;
+  result.finished = final_board.game_over() || settled;
+  result.settled = settled;
+  result.actions = std::move(actions);
+  return result;
+}
+
+double MatchGame::score_for_a() const {
+  if (result.winner == Color::Empty)
+    return 0.5;
+  bool black_won = result.winner == Color::Black;
+  return black_won == a_is_black ? 1.0 : 0.0;
+}
+
+void run_match(const PlayerFactory &a, const PlayerFactory &b,
+               const MatchConfig &config,
+               const std::function<bool(const MatchGame &)> &on_game) {
+  int threads = config.num_threads > 0
+                    ? config.num_threads
+                    : static_cast<int>(std::thread::hardware_concurrency());
+  threads = std::max(1, std::min(threads, config.num_games));
+  int max_moves = config.max_moves > 0
+                      ? config.max_moves
+                      : 4 * config.board_size * config.board_size;
+  unsigned base_seed =
+      config.seed != 0 ? config.seed : std::random_device{}();
+
+  std::atomic<int> next_game{0};
+  std::atomic<bool> stop{false};
+  std::mutex report_mutex;
+
+  auto worker = [&] {
+    for (;;) {
+      int i = next_game.fetch_add(1);
+      if (i >= config.num_games || stop)
+        return;
+
+      MatchGame game;
+      game.index = i;
+      game.a_is_black = i % 2 == 0;
+      game.komi = config.komis.empty()
+                      ? 6.5
+                      : config.komis[(i / 2) % config.komis.size()];
+
+      // Seeds depend only on the game index, so a match is reproducible
+      // regardless of thread count.
+      unsigned seed_a = base_seed + 2 * static_cast<unsigned>(i);
+      Player pa = a(seed_a, game.komi);
+      Player pb = b(seed_a + 1, game.komi);
+      game.result =
+          game.a_is_black
+              ? play_game(pa, pb, config.board_size, game.komi, max_moves,
+                          config.superko, config.stop_when_settled)
+              : play_game(pb, pa, config.board_size, game.komi, max_moves,
+                          config.superko, config.stop_when_settled);
+
+      std::lock_guard<std::mutex> lock(report_mutex);
+      if (stop)
+        return;
+      if (!on_game(game))
+        stop = true;
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for (int t = 0; t < threads; ++t)
+    pool.emplace_back(worker);
+  for (auto &t : pool)
+    t.join();
+}
+
+// ── Statistics ──────────────────────────────────────────────────────────────
+
+void MatchSummary::add(const MatchGame &game) {
+  double s = game.score_for_a();
+  if (s == 1.0)
+    ++wins;
+  else if (s == 0.0)
+    ++losses;
+  else
+    ++draws;
+  if (game.a_is_black) {
+    ++games_as_black;
+    wins_as_black += s == 1.0;
+  }
+  if (!game.result.finished)
+    ++unfinished;
+  if (game.result.settled)
+    ++settled;
+  double margin = game.result.black_score - game.result.white_score;
+  if (!game.a_is_black)
+    margin = -margin;
+  margin_sum += margin;
+  margin_sq_sum += margin * margin;
+  game_lengths.push_back(game.result.num_moves);
+}
+
+long long MatchSummary::total_moves() const {
+  long long total = 0;
+  for (int n : game_lengths)
+    total += n;
+  return total;
+}
+
+double MatchSummary::mean_margin() const {
+  return games() > 0 ? margin_sum / games() : 0.0;
+}
+
+double MatchSummary::margin_stddev() const {
+  if (games() < 2)
+    return 0.0;
+  double mean = mean_margin();
+  double var = (margin_sq_sum - games() * mean * mean) / (games() - 1);
+  return std::sqrt(std::max(0.0, var));
+}
+
+int MatchSummary::length_percentile(double q) const {
+  if (game_lengths.empty())
+    return 0;
+  std::vector<int> sorted = game_lengths;
+  std::sort(sorted.begin(), sorted.end());
+  size_t rank = static_cast<size_t>(std::ceil(q * sorted.size()));
+  return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+WinRate win_rate(int wins, int draws, int losses, double z) {
+  double n = wins + draws + losses;
+  if (n == 0)
+    return {0.5, 0.0, 1.0};
+  double p = (wins + 0.5 * draws) / n;
+  double z2 = z * z;
+  double denom = 1 + z2 / n;
+  double center = (p + z2 / (2 * n)) / denom;
+  double half = z * std::sqrt(p * (1 - p) / n + z2 / (4 * n * n)) / denom;
+  return {p, std::max(0.0, center - half), std::min(1.0, center + half)};
+}
+
+double score_to_elo(double score) {
+  return -400.0 * std::log10(1.0 / score - 1.0);
+}
+
+namespace {
+
+double elo_to_score(double elo) {
+  return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+} // namespace
+
+Sprt::Sprt(double elo0, double elo1, double alpha, double beta)
+    : score0_(elo_to_score(elo0)), score1_(elo_to_score(elo1)),
+      lower_(std::log(beta / (1 - alpha))),
+      upper_(std::log((1 - beta) / alpha)) {}
+
+void Sprt::add(double score) {
+  if (score >= 1.0)
+    ++wins_;
+  else if (score <= 0.0)
+    ++losses_;
+  else
+    ++draws_;
+}
+
+double Sprt::llr() const {
+  if (games() == 0)
+    return 0.0;
+  // One virtual win and loss keep the variance positive, so a one-sided
+  // start does not end the test after a single game.
+  double w = wins_ + 1.0, d = draws_, l = losses_ + 1.0;
+  double n = w + d + l;
+  double s = (w + 0.5 * d) / n;
+  double var =
+      (w * (1 - s) * (1 - s) + d * (0.5 - s) * (0.5 - s) + l * s * s) / n;
+  return n * (score1_ - score0_) * (2 * s - score0_ - score1_) / (2 * var);
+}
+
+Sprt::Status Sprt::status() const {
+  double l = llr();
+  if (l >= upper_)
+    return Status::AcceptH1;
+  if (l <= lower_)
+    return Status::AcceptH0;
+  return Status::Continue;
+}
+
+} // namespace double_go
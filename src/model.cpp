@@ -1,5 +1,8 @@
 #include "double-go/model.h"
 
+#include <cmath>
+#include <limits>
+
 namespace double_go {
 
 torch::Tensor Model::encode(const std::deque<Board> &boards) {
@@ -43,4 +46,76 @@ torch::Tensor Model::encode(const std::deque<Board> &boards) {
   return encoding;
 }
 
-} // namespace double_go
\ No newline at end of file
+namespace {
+
+// Folds an eval-mode batch norm into the convolution that feeds it. The
+// folded weights are fresh tensors, so weights backed by a read-only
+// checkpoint mapping are never written.
+void fold_batch_norm(nn::Conv2d &conv, nn::BatchNorm2d &bn) {
+  auto scale = bn->weight / torch::sqrt(bn->running_var + bn->options.eps());
+  conv->weight.set_data(conv->weight * scale.view({-1, 1, 1, 1}));
+  conv->bias.set_data((conv->bias - bn->running_mean) * scale + bn->bias);
+}
+
+} // namespace
+
+void Model::fuse() {
+  if (is_fused()) {
+    return;
+  }
+  torch::NoGradGuard no_grad;
+  eval();
+  for (size_t i = 0; i < blocks->size(); ++i) {
+    auto &block = blocks->at<ResidualBlock>(i);
+    fold_batch_norm(block.conv1, block.bn1);
+    fold_batch_norm(block.conv2, block.bn2);
+    block.fused = true;
+  }
+  fold_batch_norm(policy_head->conv, policy_head->bn);
+  policy_head->fused = true;
+  fold_batch_norm(value_head->conv, value_head->bn);
+  value_head->fused = true;
+}
+
+void copy_weights(const Model &src, Model &dst) {
+  torch::NoGradGuard no_grad;
+  auto dst_params = dst.named_parameters();
+  for (const auto &p : src.named_parameters()) {
+    dst_params[p.key()].copy_(p.value());
+  }
+  auto dst_buffers = dst.named_buffers();
+  for (const auto &b : src.named_buffers()) {
+    dst_buffers[b.key()].copy_(b.value());
+  }
+}
+
+Action sample_action(const Tensor &logits, const Board &board,
+                     double temperature, std::mt19937 &rng) {
+  auto row = logits.to(torch::kCPU, torch::kFloat).contiguous();
+  auto l = row.accessor<float, 1>();
+  auto actions = board.legal_actions();
+  int size = board.size();
+
+  float max_logit = -std::numeric_limits<float>::infinity();
+  size_t best = 0;
+  for (size_t i = 0; i < actions.size(); ++i) {
+    float v = l[action_index(actions[i], size)];
+    if (v > max_logit) {
+      max_logit = v;
+      best = i;
+    }
+  }
+  if (temperature <= 0.0) {
+    return actions[best];
+  }
+
+  std::vector<double> weights(actions.size());
+  for (size_t i = 0; i < actions.size(); ++i) {
+    float v = l[action_index(actions[i], size)];
+    weights[i] = std::exp((v - max_logit) / temperature);
+  }
+  std::discrete_distribution<size_t> dist(weights.begin(), weights.end());
+  return actions[dist(rng)];
+}
+
+} // namespace double_go
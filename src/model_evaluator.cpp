@@ -0,0 +1,21 @@
+#include "double-go/model_evaluator.h"
+
+namespace double_go {
+
+ModelEvaluator::ModelEvaluator(std::shared_ptr<Model> model)
+    : model_(std::move(model)) {}
+
+Evaluation ModelEvaluator::evaluate(const std::deque<Board> &history) {
+  torch::NoGradGuard no_grad;
+  auto [logits, value] =
+      model_->forward(model_->encode(history).unsqueeze(0));
+  auto probs =
+      torch::softmax(logits[0], 0).to(torch::kCPU, torch::kFloat).contiguous();
+  Evaluation ev;
+  ev.policy.assign(probs.data_ptr<float>(),
+                   probs.data_ptr<float>() + probs.numel());
+  ev.value = value.reshape({-1})[0].item<float>();
+  return ev;
+}
+
+} // namespace double_go
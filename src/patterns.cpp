@@ -0,0 +1,266 @@
+#include "double-go/patterns.h"
+
+namespace double_go {
+
+namespace {
+
+// Offsets of the 3x3 neighbours in PatternCode order.
+constexpr int DROW[8] = {-1, 0, 1, 0, -1, 1, 1, -1};
+constexpr int DCOL[8] = {0, 1, 0, -1, 1, 1, -1, -1};
+constexpr PatternCode OFF_BOARD = 3;
+
+PatternCode field(PatternCode code, int slot) {
+  return (code >> (2 * slot)) & 3;
+}
+
+std::array<uint8_t, PATTERN_COUNT> build_eye_table() {
+  std::array<uint8_t, PATTERN_COUNT> table{};
+  for (int code = 0; code < PATTERN_COUNT; code++) {
+    bool edge = false;
+    for (int slot = 0; slot < 8; slot++)
+      edge |= field(code, slot) == OFF_BOARD;
+    for (PatternCode color : {PatternCode(1), PatternCode(2)}) {
+      PatternCode other = 3 - color;
+      bool surrounded = true;
+      for (int slot = 0; slot < 4; slot++) {
+        PatternCode f = field(code, slot);
+        surrounded &= f == color || f == OFF_BOARD;
+      }
+      int enemy_diagonals = 0;
+      for (int slot = 4; slot < 8; slot++)
+        enemy_diagonals += field(code, slot) == other;
+      if (surrounded && enemy_diagonals < (edge ? 1 : 2))
+        table[code] |= color;
+    }
+  }
+  return table;
+}
+
+} // namespace
+
+bool is_eye_pattern(PatternCode code, Color color) {
+  static const std::array<uint8_t, PATTERN_COUNT> table = build_eye_table();
+  return table[code] & static_cast<uint8_t>(color);
+}
+
+PatternCode swap_colors(PatternCode code) {
+  // Empty (00) and off-board (11) are symmetric in the two bits; black (01)
+  // and white (10) trade places.
+  return ((code >> 1) & 0x5555) | ((code & 0x5555) << 1);
+}
+
+PatternBoard::PatternBoard(const Board &board)
+    : board_(board), size_(board.size()), grid_(size_ * size_),
+      codes_(size_ * size_), atari_(size_ * size_, 0),
+      group_stamp_(size_ * size_, 0), liberty_stamp_(size_ * size_, 0),
+      dirty_stamp_(size_ * size_, 0) {
+  for (int i = 0; i < size_ * size_; i++) {
+    grid_[i] = board_.at_index(i);
+    if (grid_[i] != Color::Empty)
+      stones_.push_back(i);
+  }
+  for (int i = 0; i < size_ * size_; i++)
+    codes_[i] = compute_code(i);
+  update_atari(stones_);
+  dirty_.clear();
+}
+
+PatternCode PatternBoard::compute_code(int idx) const {
+  int row = idx / size_, col = idx % size_;
+  PatternCode code = 0;
+  for (int slot = 0; slot < 8; slot++) {
+    int r = row + DROW[slot], c = col + DCOL[slot];
+    PatternCode f = r < 0 || r >= size_ || c < 0 || c >= size_
+                        ? OFF_BOARD
+                        : static_cast<PatternCode>(grid_[r * size_ + c]);
+    code |= f << (2 * slot);
+  }
+  return code;
+}
+
+void PatternBoard::mark_dirty(int idx) {
+  if (dirty_stamp_[idx] != dirty_round_) {
+    dirty_stamp_[idx] = dirty_round_;
+    dirty_.push_back(idx);
+  }
+}
+
+bool PatternBoard::apply(Action a) {
+  if (!board_.apply(a))
+    return false;
+  dirty_.clear();
+  ++dirty_round_;
+  if (a.type != ActionType::Place)
+    return true;
+
+  auto for_each_neighbor = [&](int idx, auto &&f) {
+    int r = idx / size_, c = idx % size_;
+    if (r > 0)
+      f(idx - size_);
+    if (r < size_ - 1)
+      f(idx + size_);
+    if (c > 0)
+      f(idx - 1);
+    if (c < size_ - 1)
+      f(idx + 1);
+  };
+
+  // The placed stone, plus any opponent stones the board removed.
+  int p = a.point.row * size_ + a.point.col;
+  Color placed = board_.at_index(p);
+  grid_[p] = placed;
+  changed_.assign(1, p);
+  for_each_neighbor(p, [&](int n) {
+    if (grid_[n] != opponent(placed) || board_.at_index(n) != Color::Empty)
+      return;
+    grid_[n] = Color::Empty;
+    stack_.assign(1, n);
+    while (!stack_.empty()) {
+      int q = stack_.back();
+      stack_.pop_back();
+      changed_.push_back(q);
+      for_each_neighbor(q, [&](int m) {
+        if (grid_[m] == opponent(placed)) {
+          grid_[m] = Color::Empty;
+          stack_.push_back(m);
+        }
+      });
+    }
+  });
+
+  stones_.clear();
+  for (int q : changed_) {
+    mark_dirty(q);
+    int row = q / size_, col = q % size_;
+    for (int slot = 0; slot < 8; slot++) {
+      int r = row + DROW[slot], c = col + DCOL[slot];
+      if (r < 0 || r >= size_ || c < 0 || c >= size_)
+        continue;
+      int n = r * size_ + c;
+      codes_[n] = compute_code(n);
+      mark_dirty(n);
+      if (slot < 4 && grid_[n] != Color::Empty)
+        stones_.push_back(n);
+    }
+    if (grid_[q] != Color::Empty)
+      stones_.push_back(q);
+  }
+  update_atari(stones_);
+  return true;
+}
+
+void PatternBoard::update_atari(const std::vector<int> &stones) {
+  // Only groups touching a changed point can have gained or lost liberties,
+  // so those are the only ones recounted.
+  uint32_t round = ++stamp_;
+  size_t first_new = atari_groups_.size();
+  for (int s : stones) {
+    if (group_stamp_[s] == round)
+      continue;
+    Color color = grid_[s];
+    uint32_t libs_round = ++stamp_;
+    int libs = 0, last = -1;
+    group_stamp_[s] = round;
+    stack_.assign(1, s);
+    while (!stack_.empty()) {
+      int q = stack_.back();
+      stack_.pop_back();
+      int r = q / size_, c = q % size_;
+      int nbrs[4], n = 0;
+      if (r > 0)
+        nbrs[n++] = q - size_;
+      if (r < size_ - 1)
+        nbrs[n++] = q + size_;
+      if (c > 0)
+        nbrs[n++] = q - 1;
+      if (c < size_ - 1)
+        nbrs[n++] = q + 1;
+      for (int j = 0; j < n; j++) {
+        int m = nbrs[j];
+        if (grid_[m] == Color::Empty) {
+          if (liberty_stamp_[m] != libs_round) {
+            liberty_stamp_[m] = libs_round;
+            ++libs;
+            last = m;
+            // Self-atari at a liberty depends on the group's liberty count.
+            mark_dirty(m);
+          }
+        } else if (grid_[m] == color && group_stamp_[m] != round) {
+          group_stamp_[m] = round;
+          stack_.push_back(m);
+        }
+      }
+    }
+    if (libs == 1)
+      atari_groups_.push_back({s, last, color});
+  }
+
+  // Drop the old records of groups that were recounted or captured, then
+  // rebuild the flags wherever a record came or went.
+  touched_.clear();
+  size_t kept = 0;
+  for (size_t i = 0; i < atari_groups_.size(); i++) {
+    const AtariGroup &g = atari_groups_[i];
+    bool stale = i < first_new && (group_stamp_[g.stone] == round ||
+                                   grid_[g.stone] != g.color);
+    if (stale) {
+      touched_.push_back(g.liberty);
+      continue;
+    }
+    if (i >= first_new)
+      touched_.push_back(g.liberty);
+    atari_groups_[kept++] = g;
+  }
+  atari_groups_.resize(kept);
+  for (int p : touched_) {
+    atari_[p] = 0;
+    mark_dirty(p);
+  }
+  for (const AtariGroup &g : atari_groups_)
+    atari_[g.liberty] |= atari_bit(g.color);
+}
+
+bool PatternBoard::is_self_atari(int idx, Color mover) const {
+  PatternCode code = codes_[idx];
+  int empty = 0;
+  for (int slot = 0; slot < 4; slot++)
+    empty += field(code, slot) == 0;
+  if (empty >= 2 || captures(idx, mover))
+    return false;
+
+  // Count the liberties the new group would have, stopping at two.
+  uint32_t round = ++stamp_;
+  group_stamp_[idx] = round;
+  liberty_stamp_[idx] = round;
+  int libs = 0;
+  stack_.assign(1, idx);
+  while (!stack_.empty() && libs < 2) {
+    int q = stack_.back();
+    stack_.pop_back();
+    int r = q / size_, c = q % size_;
+    int nbrs[4], n = 0;
+    if (r > 0)
+      nbrs[n++] = q - size_;
+    if (r < size_ - 1)
+      nbrs[n++] = q + size_;
+    if (c > 0)
+      nbrs[n++] = q - 1;
+    if (c < size_ - 1)
+      nbrs[n++] = q + 1;
+    for (int j = 0; j < n; j++) {
+      int m = nbrs[j];
+      if (grid_[m] == Color::Empty) {
+        if (liberty_stamp_[m] != round) {
+          liberty_stamp_[m] = round;
+          ++libs;
+        }
+      } else if (grid_[m] == mover && group_stamp_[m] != round) {
+        group_stamp_[m] = round;
+        stack_.push_back(m);
+      }
+    }
+  }
+  return libs < 2;
+}
+
+} // namespace double_go
@@ -0,0 +1,58 @@
+#include "double-go/players.h"
+
+#include "double-go/bot.h"
+#include "double-go/rollout.h"
+
+#include <memory>
+
+namespace double_go {
+
+PlayerFactory make_player_factory(const std::string &name,
+                                  const SearchConfig &search,
+                                  SearchObserver observer) {
+  if (name == "random") {
+    return [](unsigned seed, double) -> Player {
+      auto bot = std::make_shared<RandomBot>(seed);
+      return [bot](const std::deque<Board> &history) {
+        return bot->pick_action(history.back());
+      };
+    };
+  }
+  if (name == "rollout" || name.rfind("rollout:", 0) == 0) {
+    std::shared_ptr<const RolloutWeights> weights;
+    if (name != "rollout")
+      weights = std::make_shared<const RolloutWeights>(
+          RolloutWeights::load(name.substr(8)));
+    return [weights](unsigned seed, double) -> Player {
+      auto bot = std::make_shared<RolloutBot>(weights, seed);
+      return [bot](const std::deque<Board> &history) {
+        return bot->pick_action(history.back());
+      };
+    };
+  }
+  std::string kind = name.substr(0, name.find(':'));
+  if (kind == "mcts" || kind == "gumbel") {
+    std::shared_ptr<const RolloutWeights> weights;
+    if (name != kind)
+      weights = std::make_shared<const RolloutWeights>(
+          RolloutWeights::load(name.substr(kind.size() + 1)));
+    SearchConfig config = search;
+    if (kind == "gumbel")
+      config.root_policy = RootPolicy::Gumbel;
+    return [weights, config, observer](unsigned seed, double komi) -> Player {
+      auto evaluator = std::make_shared<RolloutEvaluator>(weights, komi, seed);
+      SearchConfig game = config;
+      game.seed = seed;
+      game.komi = komi;
+      auto bot = std::make_shared<MctsBot>(evaluator, game);
+      if (observer)
+        bot->set_observer(observer);
+      return [bot](const std::deque<Board> &history) {
+        return bot->pick_action(history);
+      };
+    };
+  }
+  return {};
+}
+
+} // namespace double_go
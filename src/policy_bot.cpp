@@ -0,0 +1,15 @@
+#include "double-go/policy_bot.h"
+
+namespace double_go {
+
+PolicyBot::PolicyBot(std::shared_ptr<Model> model, double temperature,
+                     unsigned seed)
+    : model_(std::move(model)), temperature_(temperature), rng_(seed) {}
+
+Action PolicyBot::pick_action(const std::deque<Board> &history) {
+  torch::NoGradGuard no_grad;
+  auto logits = model_->forward(model_->encode(history).unsqueeze(0)).first;
+  return sample_action(logits[0], history.back(), temperature_, rng_);
+}
+
+} // namespace double_go
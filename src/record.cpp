@@ -0,0 +1,103 @@
+#include "double-go/record.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace double_go {
+
+GameRecord::GameRecord(int board_size, double komi, int keyframe_interval)
+    : board_size_(board_size), komi_(komi),
+      interval_(keyframe_interval > 0 ? keyframe_interval : 1),
+      last_(board_size) {
+  keyframes_.push_back(last_);
+}
+
+bool GameRecord::add(Action a) {
+  if (!last_.apply(a))
+    return false;
+  actions_.push_back(a);
+  if (num_moves() % interval_ == 0)
+    keyframes_.push_back(last_);
+  return true;
+}
+
+Board GameRecord::position(int move) const {
+  move = std::clamp(move, 0, num_moves());
+  int k = move / interval_;
+  Board board = keyframes_[k];
+  for (int i = k * interval_; i < move; i++)
+    board.apply(actions_[i]);
+  return board;
+}
+
+// ── Record files ────────────────────────────────────────────────────────────
+
+namespace {
+
+[[noreturn]] void fail(const std::string &name, int line,
+                       const std::string &what) {
+  throw std::runtime_error(name + ":" + std::to_string(line) + ": " + what);
+}
+
+} // namespace
+
+void write_record(std::ostream &out, const GameRecord &record) {
+  int size = record.board_size();
+  out << size << ' ' << record.komi();
+  for (Action a : record.actions())
+    out << ' ' << action_index(a, size);
+  out << '\n';
+}
+
+std::vector<GameRecord> read_records(std::istream &in,
+                                     const std::string &name) {
+  std::vector<GameRecord> records;
+  std::string text;
+  for (int line = 1; std::getline(in, text); line++) {
+    if (text.empty() || text[0] == '#')
+      continue;
+    std::istringstream fields(text);
+    int size;
+    double komi;
+    if (!(fields >> size >> komi) || size < 1 || size > 19)
+      fail(name, line, "expected board size and komi");
+    GameRecord record(size, komi);
+    int idx;
+    while (fields >> idx) {
+      if (idx < 0 || idx > size * size)
+        fail(name, line, "action " + std::to_string(idx) + " out of range");
+      if (!record.add(index_action(idx, size)))
+        fail(name, line,
+             "illegal action at move " +
+                 std::to_string(record.num_moves() + 1));
+    }
+    if (!fields.eof())
+      fail(name, line, "malformed action");
+    records.push_back(std::move(record));
+  }
+  if (in.bad())
+    throw std::runtime_error(name + ": read failed");
+  return records;
+}
+
+std::vector<GameRecord> load_records(const std::string &path) {
+  std::ifstream in(path);
+  if (!in)
+    throw std::runtime_error(path + ": cannot open");
+  return read_records(in, path);
+}
+
+void save_records(const std::string &path,
+                  const std::vector<GameRecord> &records) {
+  std::ofstream out(path, std::ios::trunc);
+  if (!out)
+    throw std::runtime_error(path + ": cannot open for writing");
+  for (const auto &record : records)
+    write_record(out, record);
+  if (!out)
+    throw std::runtime_error(path + ": write failed");
+}
+
+} // namespace double_go
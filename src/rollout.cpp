@@ -0,0 +1,275 @@
+#include "double-go/rollout.h"
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace double_go {
+
+// ── FenwickSampler ──────────────────────────────────────────────────────────
+
+FenwickSampler::FenwickSampler(int n) { reset(n); }
+
+void FenwickSampler::reset(int n) {
+  tree_.assign(n + 1, 0.0);
+  weights_.assign(n, 0.0);
+  total_ = 0.0;
+  top_bit_ = 1;
+  while (top_bit_ * 2 <= n)
+    top_bit_ *= 2;
+}
+
+void FenwickSampler::set(int i, double weight) {
+  double delta = weight - weights_[i];
+  if (delta == 0.0)
+    return;
+  weights_[i] = weight;
+  total_ += delta;
+  int n = static_cast<int>(weights_.size());
+  for (int j = i + 1; j <= n; j += j & -j)
+    tree_[j] += delta;
+}
+
+int FenwickSampler::find(double u) const {
+  int n = static_cast<int>(weights_.size());
+  int pos = 0;
+  double rest = u;
+  for (int step = top_bit_; step > 0; step >>= 1) {
+    if (pos + step <= n && tree_[pos + step] <= rest) {
+      pos += step;
+      rest -= tree_[pos];
+    }
+  }
+  if (pos < n && weights_[pos] > 0.0)
+    return pos;
+  // Rounding: take the last non-zero slot at or before the landing point.
+  for (int i = std::min(pos, n - 1); i >= 0; --i)
+    if (weights_[i] > 0.0)
+      return i;
+  return -1;
+}
+
+// ── RolloutWeights ──────────────────────────────────────────────────────────
+
+RolloutWeights RolloutWeights::defaults() {
+  RolloutWeights w;
+  w.capture = 3.0f;
+  w.extend_atari = 2.0f;
+  w.self_atari = -3.0f;
+  return w;
+}
+
+float RolloutWeights::log_weight(const PatternBoard &pb, int idx,
+                                 Color mover) const {
+  PatternCode code = pb.pattern(idx);
+  if (mover == Color::White)
+    code = swap_colors(code);
+  float w = pattern[code];
+  if (pb.captures(idx, mover))
+    w += capture;
+  if (pb.extends_atari(idx, mover))
+    w += extend_atari;
+  if (self_atari != 0.0f && pb.is_self_atari(idx, mover))
+    w += self_atari;
+  return w;
+}
+
+std::optional<double> RolloutWeights::train_step(const Board &board,
+                                                 Point played,
+                                                 double learning_rate) {
+  PatternBoard pb(board);
+  Color mover = board.to_play();
+  int n = board.size() * board.size();
+
+  struct Candidate {
+    int idx;
+    PatternCode code;
+    bool capture, extend, self_atari;
+    double logit;
+  };
+  std::vector<Candidate> candidates;
+  int chosen = -1;
+  double max_logit = -INFINITY;
+  for (int i = 0; i < n; i++) {
+    Point p{i / board.size(), i % board.size()};
+    if (board.at_index(i) != Color::Empty || pb.is_eye(i, mover) ||
+        !board.is_legal(p))
+      continue;
+    PatternCode code = pb.pattern(i);
+    if (mover == Color::White)
+      code = swap_colors(code);
+    Candidate c{i, code, pb.captures(i, mover), pb.extends_atari(i, mover),
+                pb.is_self_atari(i, mover), 0.0};
+    c.logit = pattern[code] + (c.capture ? capture : 0.0f) +
+              (c.extend ? extend_atari : 0.0f) +
+              (c.self_atari ? self_atari : 0.0f);
+    max_logit = std::max(max_logit, c.logit);
+    if (p == played)
+      chosen = static_cast<int>(candidates.size());
+    candidates.push_back(c);
+  }
+  if (chosen < 0 || candidates.size() < 2)
+    return std::nullopt;
+
+  double sum = 0.0;
+  for (auto &c : candidates) {
+    c.logit = std::exp(c.logit - max_logit);
+    sum += c.logit;
+  }
+  double loss = -std::log(candidates[chosen].logit / sum);
+
+  // d(loss)/dw for each feature is its expected count under the policy
+  // minus its count on the played move.
+  double grad_capture = 0, grad_extend = 0, grad_self_atari = 0;
+  for (size_t k = 0; k < candidates.size(); k++) {
+    const Candidate &c = candidates[k];
+    double g = c.logit / sum - (static_cast<int>(k) == chosen ? 1.0 : 0.0);
+    pattern[c.code] -= static_cast<float>(learning_rate * g);
+    grad_capture += c.capture * g;
+    grad_extend += c.extend * g;
+    grad_self_atari += c.self_atari * g;
+  }
+  capture -= static_cast<float>(learning_rate * grad_capture);
+  extend_atari -= static_cast<float>(learning_rate * grad_extend);
+  self_atari -= static_cast<float>(learning_rate * grad_self_atari);
+  return loss;
+}
+
+namespace {
+
+constexpr char MAGIC[8] = {'D', 'G', 'R', 'O', 'L', 'L', '\0', '\0'};
+constexpr uint32_t VERSION = 1;
+
+[[noreturn]] void fail(const std::string &path, const std::string &what) {
+  throw std::runtime_error("rollout weights " + path + ": " + what);
+}
+
+} // namespace
+
+void RolloutWeights::save(const std::string &path) const {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out)
+    fail(path, "cannot open for writing");
+  uint32_t header[2] = {VERSION, static_cast<uint32_t>(pattern.size())};
+  float tactical[3] = {capture, extend_atari, self_atari};
+  out.write(MAGIC, sizeof(MAGIC));
+  out.write(reinterpret_cast<const char *>(header), sizeof(header));
+  out.write(reinterpret_cast<const char *>(pattern.data()),
+            pattern.size() * sizeof(float));
+  out.write(reinterpret_cast<const char *>(tactical), sizeof(tactical));
+  if (!out)
+    fail(path, "write failed");
+}
+
+RolloutWeights RolloutWeights::load(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in)
+    fail(path, "cannot open");
+  char magic[8];
+  uint32_t header[2];
+  in.read(magic, sizeof(magic));
+  in.read(reinterpret_cast<char *>(header), sizeof(header));
+  if (!in || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+    fail(path, "not a rollout weights file");
+  if (header[0] != VERSION)
+    fail(path, "unsupported version " + std::to_string(header[0]));
+  if (header[1] != PATTERN_COUNT)
+    fail(path, "unexpected pattern count " + std::to_string(header[1]));
+
+  RolloutWeights w;
+  float tactical[3];
+  in.read(reinterpret_cast<char *>(w.pattern.data()),
+          w.pattern.size() * sizeof(float));
+  in.read(reinterpret_cast<char *>(tactical), sizeof(tactical));
+  if (!in)
+    fail(path, "truncated");
+  w.capture = tactical[0];
+  w.extend_atari = tactical[1];
+  w.self_atari = tactical[2];
+  return w;
+}
+
+// ── RolloutBot ──────────────────────────────────────────────────────────────
+
+RolloutBot::RolloutBot(std::shared_ptr<const RolloutWeights> weights,
+                       unsigned seed)
+    : weights_(weights ? std::move(weights)
+                       : std::make_shared<const RolloutWeights>(
+                             RolloutWeights::defaults())),
+      rng_(seed) {}
+
+void RolloutBot::rescore(const PatternBoard &pb, int idx) {
+  bool empty = pb.board().at_index(idx) == Color::Empty;
+  for (Color c : {Color::Black, Color::White}) {
+    double w = 0.0;
+    if (empty && !pb.is_eye(idx, c))
+      w = std::exp(weights_->log_weight(pb, idx, c));
+    samplers_[c == Color::Black ? 0 : 1].set(idx, w);
+  }
+}
+
+Action RolloutBot::sample(const PatternBoard &pb, FenwickSampler &sampler) {
+  const Board &board = pb.board();
+  int size = board.size();
+  // Candidates that turn out illegal (ko, suicide, superko) are zeroed for
+  // this draw; the caller restores them after the move.
+  while (sampler.total() > 0.0) {
+    std::uniform_real_distribution<double> u(0.0, sampler.total());
+    int i = sampler.find(u(rng_));
+    if (i < 0)
+      break;
+    Point p{i / size, i % size};
+    if (board.is_legal(p))
+      return Action::place(p);
+    sampler.set(i, 0.0);
+    rejected_.push_back(i);
+  }
+  return Action::pass();
+}
+
+Action RolloutBot::pick_action(const Board &board) {
+  PatternBoard pb(board);
+  int n = board.size() * board.size();
+  Color mover = board.to_play();
+  FenwickSampler &sampler = samplers_[mover == Color::Black ? 0 : 1];
+  sampler.reset(n);
+  for (int i = 0; i < n; i++) {
+    if (board.at_index(i) == Color::Empty && !pb.is_eye(i, mover))
+      sampler.set(i, std::exp(weights_->log_weight(pb, i, mover)));
+  }
+  Action a = sample(pb, sampler);
+  rejected_.clear();
+  return a;
+}
+
+Board RolloutBot::playout(const Board &board, int max_moves) {
+  auto history = board.position_history();
+  size_t mark = history ? history->mark() : 0;
+
+  PatternBoard pb(board);
+  int n = board.size() * board.size();
+  for (auto &s : samplers_)
+    s.reset(n);
+  for (int i = 0; i < n; i++)
+    rescore(pb, i);
+
+  for (int m = 0; m < max_moves && !pb.board().game_over(); m++) {
+    Color mover = pb.board().to_play();
+    Action a = sample(pb, samplers_[mover == Color::Black ? 0 : 1]);
+    if (!pb.apply(a))
+      pb.apply(Action::pass());
+    for (int i : pb.dirty())
+      rescore(pb, i);
+    for (int i : rejected_)
+      rescore(pb, i);
+    rejected_.clear();
+  }
+
+  Board result = pb.board();
+  if (history)
+    history->rollback(mark);
+  return result;
+}
+
+} // namespace double_go
@@ -0,0 +1,590 @@
+#include "double-go/search.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace double_go {
+
+namespace {
+
+// Floor for priors under a logarithm; half precision rounds small ones to 0.
+constexpr float MIN_PRIOR = 1e-8f;
+
+// +1 if the side to move has won the scored position, -1 if it has lost.
+float outcome(const ScoreResult &score, Color to_play) {
+  if (score.black_score == score.white_score)
+    return 0.0f;
+  Color winner =
+      score.black_score > score.white_score ? Color::Black : Color::White;
+  return winner == to_play ? 1.0f : -1.0f;
+}
+
+// Legal actions of board in descending order of prior.
+std::vector<int> ranked_actions(const Board &board,
+                                const std::vector<float> &policy) {
+  std::vector<int> ranked;
+  int size = board.size();
+  for (Action a : board.legal_actions())
+    ranked.push_back(action_index(a, size));
+  std::stable_sort(ranked.begin(), ranked.end(),
+                   [&](int x, int y) { return policy[x] > policy[y]; });
+  return ranked;
+}
+
+} // namespace
+
+// ── RolloutEvaluator ────────────────────────────────────────────────────────
+
+RolloutEvaluator::RolloutEvaluator(
+    std::shared_ptr<const RolloutWeights> weights, double komi, unsigned seed)
+    : weights_(weights ? std::move(weights)
+                       : std::make_shared<const RolloutWeights>(
+                             RolloutWeights::defaults())),
+      bot_(weights_, seed), komi_(komi) {}
+
+Evaluation RolloutEvaluator::evaluate(const std::deque<Board> &history) {
+  const Board &board = history.back();
+  int total = board.size() * board.size();
+  Color me = board.to_play();
+
+  Evaluation ev;
+  ev.policy.assign(total + 1, 0.0f);
+  PatternBoard pb(board);
+  constexpr float NONE = -std::numeric_limits<float>::infinity();
+  std::vector<float> logits(total, NONE);
+  float max_logit = 0.0f; // pass
+  for (int i = 0; i < total; i++) {
+    if (board.at_index(i) != Color::Empty || pb.is_eye(i, me))
+      continue;
+    logits[i] = weights_->log_weight(pb, i, me);
+    max_logit = std::max(max_logit, logits[i]);
+  }
+  for (int i = 0; i < total; i++)
+    if (logits[i] != NONE)
+      ev.policy[i] = std::exp(logits[i] - max_logit);
+  ev.policy[total] = std::exp(-max_logit);
+
+  Board final = bot_.playout(board, 3 * total);
+  ev.value = outcome(final.score(komi_), me);
+  return ev;
+}
+
+// ── Tree storage ────────────────────────────────────────────────────────────
+
+uint16_t float_to_half(float f) {
+  uint32_t x;
+  std::memcpy(&x, &f, sizeof x);
+  uint16_t sign = (x >> 16) & 0x8000;
+  uint32_t exponent = (x >> 23) & 0xFF;
+  uint32_t mantissa = x & 0x7FFFFF;
+  if (exponent == 0xFF)
+    return sign | 0x7C00 | (mantissa ? 0x200 : 0);
+  int e = static_cast<int>(exponent) - 127 + 15;
+  if (e >= 31)
+    return sign | 0x7C00;
+  // Drops the low shift bits of m, rounding to nearest even. A carry out of
+  // the mantissa correctly bumps the exponent.
+  auto round = [](uint32_t m, int shift) {
+    uint32_t h = m >> shift;
+    uint32_t rest = m & ((1u << shift) - 1);
+    uint32_t half_way = 1u << (shift - 1);
+    return h + (rest > half_way || (rest == half_way && (h & 1)));
+  };
+  if (e <= 0) {
+    if (e < -10)
+      return sign;
+    return sign | round(mantissa | 0x800000, 14 - e);
+  }
+  return sign | round((static_cast<uint32_t>(e) << 23) | mantissa, 13);
+}
+
+float half_to_float(uint16_t h) {
+  uint32_t sign = static_cast<uint32_t>(h & 0x8000) << 16;
+  uint32_t exponent = (h >> 10) & 0x1F;
+  uint32_t mantissa = h & 0x3FF;
+  if (exponent == 0) {
+    float f = static_cast<float>(mantissa) * 0x1p-24f;
+    return sign ? -f : f;
+  }
+  uint32_t x = exponent == 31
+                   ? sign | 0x7F800000 | (mantissa << 13)
+                   : sign | ((exponent + 112) << 23) | (mantissa << 13);
+  float f;
+  std::memcpy(&f, &x, sizeof f);
+  return f;
+}
+
+SearchTree::SearchTree() { clear(); }
+
+void SearchTree::clear() {
+  next_node_ = next_edge_ = 0;
+  num_nodes_ = num_edges_ = 0;
+  add_node();
+}
+
+uint32_t SearchTree::add_node() {
+  uint32_t i = next_node_++;
+  if ((i >> CHUNK_BITS) == nodes_.size())
+    nodes_.push_back(std::make_unique<Node[]>(MAX_EDGES));
+  node(i) = Node{};
+  num_nodes_++;
+  return i;
+}
+
+void SearchTree::allocate_edges(uint32_t n, uint32_t count) {
+  if (count == 0 || count >= MAX_EDGES)
+    throw std::length_error("SearchTree: bad edge count");
+  if ((next_edge_ & CHUNK_MASK) + count > MAX_EDGES)
+    next_edge_ = (next_edge_ | CHUNK_MASK) + 1;
+  if ((next_edge_ >> CHUNK_BITS) == edges_.size())
+    edges_.push_back(std::make_unique<Edge[]>(MAX_EDGES));
+  node(n).first_edge = next_edge_;
+  node(n).num_edges = static_cast<uint16_t>(count);
+  next_edge_ += count;
+  num_edges_ += count;
+}
+
+uint32_t SearchTree::child(uint32_t e) {
+  if (edge(e).child == NO_NODE) {
+    uint32_t c = add_node();
+    edge(e).child = c;
+  }
+  return edge(e).child;
+}
+
+// ── Search ──────────────────────────────────────────────────────────────────
+
+Search::Search(std::shared_ptr<Evaluator> evaluator, SearchConfig config)
+    : evaluator_(std::move(evaluator)), config_(config),
+      rng_(config.seed ? config.seed : std::random_device{}()) {}
+
+SearchResult Search::run(const std::deque<Board> &history,
+                         std::optional<SearchDeadline> deadline) {
+  const Board &root_board = history.back();
+  const auto &positions = root_board.position_history();
+  int size = root_board.size();
+  tree_.clear();
+  constexpr uint32_t ROOT = 0;
+
+  // Leaf histories grow from the root's; evaluators only look at the end.
+  std::deque<Board> path_history = history;
+  size_t root_len = path_history.size();
+  auto next_report = std::chrono::steady_clock::now() + observer_interval_;
+
+  int budget = std::max(1, config_.visits);
+  bool gumbel = config_.root_policy == RootPolicy::Gumbel;
+  bool early_stop = config_.early_stop && !gumbel;
+  candidates_.clear();
+  chosen_ = -1;
+  int saved = 0;
+  uint32_t leader_visits = 0; // most visits on a root edge
+  for (int sim = 0; sim < budget; sim++) {
+    if (deadline && sim > 0 && std::chrono::steady_clock::now() >= *deadline)
+      break;
+    size_t mark = positions ? positions->mark() : 0;
+    Board board = root_board;
+    uint32_t node = ROOT;
+    path_.clear();
+
+    // Including this one, every simulation left adds a root visit.
+    uint32_t left = static_cast<uint32_t>(budget - sim);
+    uint32_t contend =
+        early_stop && leader_visits > left ? leader_visits - left : 0;
+    while (tree_.node(node).num_edges && !board.game_over()) {
+      Color chooser = board.to_play();
+      uint32_t e;
+      if (node == ROOT && gumbel) {
+        // Every simulation after the one expanding the root visits it.
+        if (candidates_.empty())
+          start_gumbel(budget - 1);
+        e = select_gumbel();
+      } else {
+        e = select(node, node == ROOT ? contend : 0);
+      }
+      const SearchTree::Edge &edge = tree_.edge(e);
+      board.apply(index_action(edge.first, size));
+      if (edge.second != SearchTree::NO_ACTION) {
+        path_history.push_back(board);
+        board.apply(index_action(edge.second, size));
+      }
+      path_history.push_back(board);
+      path_.push_back({e, chooser});
+      node = tree_.child(e);
+    }
+
+    float value = board.game_over() ? terminal_value(board)
+                                    : expand(node, path_history);
+    Color leaf = board.to_play();
+    uint32_t walk = ROOT;
+    for (const Step &step : path_) {
+      SearchTree::Edge &edge = tree_.edge(step.edge);
+      tree_.node(walk).visits++;
+      edge.visits++;
+      float v = step.chooser == leaf ? value : -value;
+      edge.q += (v - edge.q) / edge.visits;
+      walk = edge.child;
+    }
+
+    path_history.resize(root_len);
+    if (positions)
+      positions->rollback(mark);
+    if (!path_.empty())
+      leader_visits = std::max(leader_visits, tree_.edge(path_[0].edge).visits);
+
+    if (observer_ && std::chrono::steady_clock::now() >= next_report) {
+      observer_(collect(size));
+      next_report = std::chrono::steady_clock::now() + observer_interval_;
+    }
+    if (stop_check_ && stop_check_(progress()))
+      break;
+    // Stop once the runner-up could not catch up with every visit left.
+    int remaining = budget - sim - 1;
+    if (early_stop && static_cast<int>(leader_visits) > remaining) {
+      SearchProgress p = progress();
+      if (p.best_visits - p.second_visits > remaining) {
+        saved = remaining;
+        break;
+      }
+    }
+  }
+
+  if (!candidates_.empty()) {
+    rank_candidates(considered_);
+    chosen_ =
+        static_cast<int>(candidates_[0].edge - tree_.node(ROOT).first_edge);
+  }
+  SearchResult result = collect(size);
+  result.saved_visits = saved;
+  if (observer_)
+    observer_(result);
+  return result;
+}
+
+SearchResult Search::collect(int size) {
+  constexpr uint32_t ROOT = 0;
+  const SearchTree::Node &root = tree_.node(ROOT);
+  SearchResult result;
+  result.visits = root.visits;
+  double value_sum = root.value;
+  int value_visits = 1;
+  uint32_t max_visits = 0;
+  for (uint32_t i = 0; i < root.num_edges; i++)
+    max_visits = std::max(max_visits, tree_.edge(root.first_edge + i).visits);
+  float mixed = mixed_value();
+  float max_logit = -std::numeric_limits<float>::infinity();
+  for (uint32_t i = 0; i < root.num_edges; i++) {
+    const SearchTree::Edge &edge = tree_.edge(root.first_edge + i);
+    SearchChild child;
+    child.first = index_action(edge.first, size);
+    if (edge.second != SearchTree::NO_ACTION)
+      child.second = index_action(edge.second, size);
+    child.prior = half_to_float(edge.prior);
+    child.visits = edge.visits;
+    child.q = edge.visits ? edge.q : root.value;
+    // The improved policy's logit, normalized below.
+    child.improved = std::log(std::max(child.prior, MIN_PRIOR)) +
+                     sigma(edge.visits ? edge.q : mixed, max_visits);
+    max_logit = std::max(max_logit, child.improved);
+    result.children.push_back(child);
+    value_sum += static_cast<double>(edge.q) * edge.visits;
+    value_visits += edge.visits;
+  }
+  result.value = static_cast<float>(value_sum / value_visits);
+  result.tree_nodes = tree_.num_nodes();
+  result.tree_edges = tree_.num_edges();
+  result.tree_bytes = tree_.bytes();
+  double improved_sum = 0.0;
+  for (SearchChild &child : result.children) {
+    child.improved = std::exp(child.improved - max_logit);
+    improved_sum += child.improved;
+  }
+  for (SearchChild &child : result.children)
+    child.improved = static_cast<float>(child.improved / improved_sum);
+
+  auto first = result.children.begin();
+  if (chosen_ >= 0)
+    std::swap(*first++, result.children[chosen_]);
+  std::stable_sort(first, result.children.end(),
+                   [](const SearchChild &a, const SearchChild &b) {
+                     if (a.visits != b.visits)
+                       return a.visits > b.visits;
+                     return a.prior > b.prior;
+                   });
+
+  // Follow the move to play, then the most visited edges, until a node
+  // none of whose edges was visited. A visited edge always has its child.
+  uint32_t node = ROOT;
+  for (;;) {
+    const SearchTree::Node &n = tree_.node(node);
+    uint32_t best = 0;
+    uint32_t best_visits = 0;
+    for (uint32_t i = 0; i < n.num_edges; i++) {
+      const SearchTree::Edge &edge = tree_.edge(n.first_edge + i);
+      if (edge.visits > best_visits) {
+        best = n.first_edge + i;
+        best_visits = edge.visits;
+      }
+    }
+    if (node == ROOT && chosen_ >= 0) {
+      best = n.first_edge + chosen_;
+      best_visits = tree_.edge(best).visits;
+    }
+    if (!best_visits)
+      break;
+    const SearchTree::Edge &edge = tree_.edge(best);
+    result.pv.push_back(index_action(edge.first, size));
+    if (edge.second != SearchTree::NO_ACTION)
+      result.pv.push_back(index_action(edge.second, size));
+    node = edge.child;
+  }
+  return result;
+}
+
+SearchProgress Search::progress() {
+  const SearchTree::Node &root = tree_.node(0);
+  SearchProgress p;
+  p.visits = root.visits;
+  p.children = root.num_edges;
+  for (uint32_t i = 0; i < root.num_edges; i++) {
+    const SearchTree::Edge &edge = tree_.edge(root.first_edge + i);
+    int visits = static_cast<int>(edge.visits);
+    if (p.best < 0 || visits > p.best_visits) {
+      if (p.best >= 0)
+        p.second_visits = p.best_visits;
+      p.best = static_cast<int>(i);
+      p.best_visits = visits;
+      p.best_q = edge.visits ? edge.q : root.value;
+    } else if (visits > p.second_visits) {
+      p.second_visits = visits;
+    }
+  }
+  return p;
+}
+
+float Search::sigma(float q, uint32_t max_visits) const {
+  return (config_.c_visit + max_visits) * config_.c_scale * (q + 1) / 2;
+}
+
+float Search::mixed_value() {
+  const SearchTree::Node &root = tree_.node(0);
+  double visits = 0, weighted_q = 0, visited_prior = 0;
+  for (uint32_t i = 0; i < root.num_edges; i++) {
+    const SearchTree::Edge &edge = tree_.edge(root.first_edge + i);
+    if (!edge.visits)
+      continue;
+    float prior = half_to_float(edge.prior);
+    visits += edge.visits;
+    weighted_q += prior * edge.q;
+    visited_prior += prior;
+  }
+  if (visits == 0 || visited_prior <= 0)
+    return root.value;
+  return static_cast<float>(
+      (root.value + visits * weighted_q / visited_prior) / (1 + visits));
+}
+
+void Search::start_gumbel(int visits) {
+  const SearchTree::Node &root = tree_.node(0);
+  std::extreme_value_distribution<float> gumbel;
+  for (uint32_t i = 0; i < root.num_edges; i++) {
+    float prior = half_to_float(tree_.edge(root.first_edge + i).prior);
+    float noise = config_.gumbel_noise ? gumbel(rng_) : 0.0f;
+    candidates_.push_back(
+        {root.first_edge + i, noise + std::log(std::max(prior, MIN_PRIOR))});
+  }
+  size_t m = std::clamp<size_t>(config_.gumbel_considered, 1,
+                                candidates_.size());
+  std::partial_sort(candidates_.begin(), candidates_.begin() + m,
+                    candidates_.end(),
+                    [](const Candidate &a, const Candidate &b) {
+                      return a.score > b.score;
+                    });
+  candidates_.resize(m);
+  considered_ = m;
+  gumbel_visits_ = std::max(1, visits);
+  gumbel_rounds_ = std::max(1, static_cast<int>(std::ceil(std::log2(m))));
+  phase_visits_ = std::max<uint32_t>(
+      1, gumbel_visits_ / (gumbel_rounds_ * static_cast<int>(m)));
+}
+
+uint32_t Search::select_gumbel() {
+  for (;;) {
+    if (considered_ == 1)
+      return candidates_[0].edge;
+    // The least visited candidate still short of this round's visits.
+    const Candidate *pick = nullptr;
+    uint32_t pick_visits = phase_visits_;
+    for (size_t i = 0; i < considered_; i++) {
+      uint32_t v = tree_.edge(candidates_[i].edge).visits;
+      if (v < pick_visits) {
+        pick = &candidates_[i];
+        pick_visits = v;
+      }
+    }
+    if (pick)
+      return pick->edge;
+    // Round over: keep the better half, which gets the next round's share.
+    rank_candidates(considered_);
+    considered_ = (considered_ + 1) / 2;
+    phase_visits_ += std::max<uint32_t>(
+        1, gumbel_visits_ / (gumbel_rounds_ * static_cast<int>(considered_)));
+  }
+}
+
+void Search::rank_candidates(size_t count) {
+  uint32_t max_visits = 0;
+  for (const Candidate &c : candidates_)
+    max_visits = std::max(max_visits, tree_.edge(c.edge).visits);
+  float mixed = mixed_value();
+  auto rank = [&](const Candidate &c) {
+    const SearchTree::Edge &edge = tree_.edge(c.edge);
+    return c.score + sigma(edge.visits ? edge.q : mixed, max_visits);
+  };
+  std::stable_sort(candidates_.begin(), candidates_.begin() + count,
+                   [&](const Candidate &a, const Candidate &b) {
+                     return rank(a) > rank(b);
+                   });
+}
+
+uint32_t Search::select(uint32_t n, uint32_t min_visits) {
+  const SearchTree::Node &node = tree_.node(n);
+  float scale = config_.c_puct * std::sqrt(static_cast<float>(
+                                     std::max<uint32_t>(1, node.visits)));
+  uint32_t best = node.first_edge;
+  float best_score = -std::numeric_limits<float>::infinity();
+  for (uint32_t i = node.first_edge; i < node.first_edge + node.num_edges;
+       i++) {
+    const SearchTree::Edge &edge = tree_.edge(i);
+    if (edge.visits < min_visits)
+      continue;
+    // Unvisited edges start at the node's own evaluation.
+    float q = edge.visits ? edge.q : node.value;
+    float score =
+        q + scale * half_to_float(edge.prior) / (1 + edge.visits);
+    if (score > best_score) {
+      best_score = score;
+      best = i;
+    }
+  }
+  return best;
+}
+
+float Search::expand(uint32_t n, const std::deque<Board> &history) {
+  const Board &board = history.back();
+  Evaluation ev = evaluator_->evaluate(history);
+  pending_.clear();
+  if (config_.macro_actions && board.phase() == Phase::First)
+    add_macro_edges(board, ev.policy);
+  else
+    add_edges(board, ev.policy);
+
+  float sum = 0.0f;
+  for (const PendingEdge &p : pending_)
+    sum += p.prior;
+  tree_.allocate_edges(n, static_cast<uint32_t>(pending_.size()));
+  SearchTree::Node &node = tree_.node(n);
+  for (size_t i = 0; i < pending_.size(); i++) {
+    float prior =
+        sum > 0.0f ? pending_[i].prior / sum : 1.0f / pending_.size();
+    tree_.edge(node.first_edge + i) = {pending_[i].first, pending_[i].second,
+                                       float_to_half(prior)};
+  }
+  node.value = ev.value;
+  return ev.value;
+}
+
+void Search::add_edges(const Board &board, const std::vector<float> &policy) {
+  for (Action a : board.legal_actions()) {
+    int idx = action_index(a, board.size());
+    pending_.push_back({static_cast<uint16_t>(idx), SearchTree::NO_ACTION,
+                        policy[idx]});
+  }
+}
+
+void Search::add_macro_edges(const Board &board,
+                             const std::vector<float> &policy) {
+  int pass = board.size() * board.size();
+  const auto &positions = board.position_history();
+  // Passing the first stone ends the turn, so it stays a single action.
+  pending_.push_back({static_cast<uint16_t>(pass), SearchTree::NO_ACTION,
+                      policy[pass]});
+
+  std::unordered_map<uint64_t, size_t> reached;
+  int firsts = 0;
+  for (int a : ranked_actions(board, policy)) {
+    if (a == pass)
+      continue;
+    if (firsts++ == config_.macro_first)
+      break;
+    size_t mark = positions ? positions->mark() : 0;
+    Board after = board;
+    after.apply(index_action(a, board.size()));
+    auto seconds = ranked_actions(after, policy);
+    seconds.resize(std::min<size_t>(seconds.size(), config_.macro_second));
+    float kept_mass = 0.0f;
+    for (int b : seconds)
+      kept_mass += policy[b];
+    for (int b : seconds) {
+      float prior = kept_mass > 0.0f ? policy[a] * policy[b] / kept_mass
+                                     : policy[a] / seconds.size();
+      size_t inner = positions ? positions->mark() : 0;
+      Board pair = after;
+      pair.apply(index_action(b, board.size()));
+      if (positions)
+        positions->rollback(inner);
+      // a then b and b then a usually reach the same position; keep one
+      // edge with the combined prior.
+      auto [it, fresh] = reached.emplace(pair.hash(), pending_.size());
+      if (fresh)
+        pending_.push_back({static_cast<uint16_t>(a),
+                            static_cast<uint16_t>(b), prior});
+      else
+        pending_[it->second].prior += prior;
+    }
+    if (positions)
+      positions->rollback(mark);
+  }
+}
+
+float Search::terminal_value(const Board &board) const {
+  return outcome(board.score(config_.komi), board.to_play());
+}
+
+// ── MctsBot ─────────────────────────────────────────────────────────────────
+
+MctsBot::MctsBot(std::shared_ptr<Evaluator> evaluator, SearchConfig config)
+    : search_(std::move(evaluator), config) {}
+
+Action MctsBot::pick_action(const std::deque<Board> &history,
+                            std::optional<SearchDeadline> deadline) {
+  const Board &board = history.back();
+  if (planned_ && board.hash() == planned_hash_ &&
+      (planned_->type == ActionType::Pass || board.is_legal(planned_->point))) {
+    Action a = *planned_;
+    planned_.reset();
+    return a;
+  }
+  planned_.reset();
+
+  SearchResult result = search_.run(history, deadline);
+  if (result.children.empty())
+    return Action::pass();
+  const SearchChild &best = result.children.front();
+  if (best.second) {
+    const auto &positions = board.position_history();
+    size_t mark = positions ? positions->mark() : 0;
+    Board after = board;
+    after.apply(best.first);
+    planned_ = best.second;
+    planned_hash_ = after.hash();
+    if (positions)
+      positions->rollback(mark);
+  }
+  return best.first;
+}
+
+} // namespace double_go
@@ -0,0 +1,406 @@
+#include "double-go/selfplay.h"
+#include "double-go/life.h"
+#include "double-go/model_evaluator.h"
+#include "double-go/search.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+namespace double_go {
+
+// ── ModelSlot ───────────────────────────────────────────────────────────────
+
+ModelSlot::Lease::Lease(Lease &&other) noexcept
+    : slot_(other.slot_), index_(other.index_),
+      generation_(other.generation_) {
+  other.slot_ = nullptr;
+}
+
+ModelSlot::Lease::~Lease() {
+  if (slot_) {
+    slot_->readers_[index_].fetch_sub(1);
+  }
+}
+
+ModelSlot::ModelSlot(const Model &initial) {
+  for (auto &buffer : buffers_) {
+    buffer = std::make_shared<Model>(initial.board_size, initial.num_blocks,
+                                     initial.num_channels);
+    copy_weights(initial, *buffer);
+    buffer->eval();
+  }
+}
+
+ModelSlot::Lease ModelSlot::acquire() const {
+  for (;;) {
+    int index = active_.load();
+    readers_[index].fetch_add(1);
+    // The trainer may have flipped the slot between the load and the
+    // increment; only keep the lease if the buffer is still live.
+    if (active_.load() == index) {
+      return Lease(this, index, buffer_generation_[index]);
+    }
+    readers_[index].fetch_sub(1);
+  }
+}
+
+void ModelSlot::publish(const Model &source) {
+  int back = 1 - active_.load();
+  while (readers_[back].load() > 0) {
+    std::this_thread::yield();
+  }
+  copy_weights(source, *buffers_[back]);
+  buffer_generation_[back] = generation_.load() + 1;
+  active_.store(back);
+  generation_.fetch_add(1);
+}
+
+// ── ReplayBuffer ────────────────────────────────────────────────────────────
+
+ReplayBuffer::ReplayBuffer(size_t capacity) : capacity_(capacity) {
+  assert(capacity > 0);
+  samples_.reserve(capacity);
+}
+
+void ReplayBuffer::add(std::vector<TrainingSample> samples) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &s : samples) {
+    if (samples_.size() < capacity_) {
+      samples_.push_back(std::move(s));
+    } else {
+      samples_[next_] = std::move(s);
+    }
+    next_ = (next_ + 1) % capacity_;
+    ++total_added_;
+  }
+}
+
+size_t ReplayBuffer::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return samples_.size();
+}
+
+uint64_t ReplayBuffer::total_added() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return total_added_;
+}
+
+std::tuple<Tensor, Tensor, Tensor>
+ReplayBuffer::sample(size_t batch_size, std::mt19937 &rng) const {
+  std::vector<Tensor> encodings, policies;
+  std::vector<float> values;
+  encodings.reserve(batch_size);
+  policies.reserve(batch_size);
+  values.reserve(batch_size);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    assert(!samples_.empty());
+    std::uniform_int_distribution<size_t> dist(0, samples_.size() - 1);
+    for (size_t i = 0; i < batch_size; ++i) {
+      const auto &s = samples_[dist(rng)];
+      encodings.push_back(s.encoding);
+      policies.push_back(s.policy);
+      values.push_back(s.value);
+    }
+  }
+  return {torch::stack(encodings), torch::stack(policies),
+          torch::tensor(values)};
+}
+
+Tensor improved_policy_target(const SearchResult &result, int board_size) {
+  Tensor policy = torch::zeros({board_size * board_size + 1});
+  auto target = policy.accessor<float, 1>();
+  // Macro-action children can share a first stone; their mass adds up.
+  for (const auto &child : result.children)
+    target[action_index(child.first, board_size)] += child.improved;
+  return policy;
+}
+
+// ── Pipeline ────────────────────────────────────────────────────────────────
+
+namespace {
+
+struct PendingSample {
+  Tensor encoding;
+  Tensor policy;
+  Color to_play;
+};
+
+struct SelfPlayGame {
+  std::deque<Board> history;
+  std::vector<PendingSample> pending;
+  GameRecord record;
+  int moves = 0;
+  bool resign_allowed;
+  // Consecutive evaluations below the resign threshold, Black then White.
+  std::array<int, 2> low_evals{};
+  // With resignation disabled, the first side that would have resigned.
+  Color would_resign = Color::Empty;
+
+  SelfPlayGame(int size, double komi, bool resign_allowed)
+      : record(size, komi), resign_allowed(resign_allowed) {
+    history.emplace_back(size);
+  }
+};
+
+int default_worker_count() {
+  int cores = static_cast<int>(std::thread::hardware_concurrency());
+  return std::max(1, cores - 1);
+}
+
+} // namespace
+
+Pipeline::Pipeline(std::shared_ptr<Model> model, SelfPlayConfig self_play,
+                   TrainerConfig trainer)
+    : model_(std::move(model)), self_play_(self_play), trainer_(trainer),
+      slot_(*model_), buffer_(trainer.buffer_capacity) {
+  if (!self_play_.record_path.empty()) {
+    records_.open(self_play_.record_path, std::ios::app);
+    if (!records_)
+      throw std::runtime_error(self_play_.record_path +
+                               ": cannot open for writing");
+  }
+}
+
+Pipeline::~Pipeline() { stop_workers(); }
+
+void Pipeline::start_workers() {
+  stop_ = false;
+  int n = self_play_.num_workers > 0 ? self_play_.num_workers
+                                     : default_worker_count();
+  for (int i = 0; i < n; ++i) {
+    workers_.emplace_back([this, i] { worker_loop(i); });
+  }
+}
+
+void Pipeline::stop_workers() {
+  stop_ = true;
+  for (auto &t : workers_) {
+    t.join();
+  }
+  workers_.clear();
+}
+
+void Pipeline::worker_loop(int worker_id) {
+  torch::NoGradGuard no_grad;
+  const int size = model_->board_size;
+  const int max_moves =
+      self_play_.max_moves > 0 ? self_play_.max_moves : 4 * size * size;
+  const bool resign_enabled = self_play_.resign_threshold > -1.0;
+  // Searches evaluate on their own, so the batched forward pass is only
+  // needed to sample moves from the policy or to check for resignation.
+  const bool batch_forward = self_play_.search_visits <= 0 || resign_enabled;
+  std::mt19937 rng(std::random_device{}() + worker_id);
+  std::bernoulli_distribution resign_disabled(
+      std::clamp(self_play_.resign_disabled_fraction, 0.0, 1.0));
+  auto new_game = [&] {
+    return SelfPlayGame(size, self_play_.komi, !resign_disabled(rng));
+  };
+
+  // The search evaluates with weights leased for one search at a time.
+  auto evaluator = std::make_shared<ModelEvaluator>(nullptr);
+  SearchConfig search_config;
+  search_config.visits = self_play_.search_visits;
+  search_config.komi = self_play_.komi;
+  search_config.root_policy = RootPolicy::Gumbel;
+  search_config.gumbel_considered = self_play_.search_considered;
+  search_config.seed = static_cast<unsigned>(rng());
+  Search search(evaluator, search_config);
+
+  std::vector<SelfPlayGame> games;
+  for (int i = 0; i < self_play_.games_per_batch; ++i) {
+    games.push_back(new_game());
+  }
+
+  // Labels a finished game's positions with the outcome and hands them to
+  // the trainer.
+  auto finish = [&](SelfPlayGame &g, Color winner) {
+    std::vector<TrainingSample> samples;
+    samples.reserve(g.pending.size());
+    for (auto &p : g.pending) {
+      float z = winner == Color::Empty ? 0.0f
+                : p.to_play == winner  ? 1.0f
+                                       : -1.0f;
+      samples.push_back({std::move(p.encoding), std::move(p.policy), z});
+    }
+    buffer_.add(std::move(samples));
+    if (g.would_resign != Color::Empty) {
+      resign_checked_.fetch_add(1);
+      if (winner == g.would_resign)
+        resign_false_positives_.fetch_add(1);
+    }
+    if (records_.is_open()) {
+      std::lock_guard<std::mutex> lock(record_mutex_);
+      write_record(records_, g.record);
+      records_.flush();
+    }
+    games_.fetch_add(1);
+    g = new_game();
+  };
+
+  while (!stop_) {
+    std::vector<Tensor> encodings;
+    encodings.reserve(games.size());
+    Tensor logits, values;
+    {
+      // Weights are only pinned for the batched forward pass, so publish
+      // never waits on a batch of searches.
+      auto lease = slot_.acquire();
+      Model &model = lease.model();
+      for (auto &g : games) {
+        encodings.push_back(model.encode(g.history));
+      }
+      if (batch_forward) {
+        auto [policy_out, value_out] = model.forward(torch::stack(encodings));
+        logits = policy_out;
+        values = value_out.reshape({-1}).contiguous();
+      }
+    }
+    const float *value = batch_forward ? values.data_ptr<float>() : nullptr;
+
+    for (size_t i = 0; i < games.size(); ++i) {
+      auto &g = games[i];
+      const Board &board = g.history.back();
+
+      if (resign_enabled) {
+        Color me = board.to_play();
+        int &low = g.low_evals[me == Color::Black ? 0 : 1];
+        low = value[i] < self_play_.resign_threshold ? low + 1 : 0;
+        if (low >= self_play_.resign_consecutive) {
+          if (g.resign_allowed) {
+            resigned_.fetch_add(1);
+            finish(g, opponent(me));
+            continue;
+          }
+          if (g.would_resign == Color::Empty)
+            g.would_resign = me;
+        }
+      }
+
+      Action action;
+      Tensor policy;
+      if (self_play_.search_visits > 0) {
+        SearchResult result;
+        {
+          // Each search leases the newest weights for its own duration.
+          auto lease = slot_.acquire();
+          evaluator->set_model(lease.shared_model());
+          result = search.run(g.history);
+          evaluator->set_model(nullptr);
+        }
+        action = result.children.empty() ? Action::pass()
+                                         : result.children.front().first;
+        policy = improved_policy_target(result, size);
+      } else {
+        // No policy target: this sample only trains the value head.
+        policy = torch::zeros({size * size + 1});
+        double temperature = g.moves < self_play_.temperature_moves
+                                 ? self_play_.temperature
+                                 : 0;
+        action = sample_action(logits[i], board, temperature, rng);
+      }
+      g.pending.push_back({encodings[i], policy, board.to_play()});
+
+      Board next = board;
+      next.apply(action);
+      g.history.push_back(std::move(next));
+      if (records_.is_open())
+        g.record.add(action);
+      if (g.history.size() > Model::HISTORY_LEN) {
+        g.history.pop_front();
+      }
+      ++g.moves;
+
+      const Board &cur = g.history.back();
+      LifeStatus life;
+      bool settled = false;
+      if (self_play_.stop_when_settled && cur.phase() == Phase::First) {
+        life = pass_alive(cur);
+        settled = settled_winner(life, self_play_.komi).has_value();
+      }
+      bool ended = cur.game_over() || settled || g.moves >= max_moves;
+      auto sr = settled ? score_pass_alive(cur, life, self_play_.komi)
+                        : cur.score(self_play_.komi);
+      if (!ended && self_play_.adjudicate_moves > 0 &&
+          g.moves >= self_play_.adjudicate_moves &&
+          std::abs(sr.black_score - sr.white_score) >=
+              self_play_.adjudicate_margin) {
+        adjudicated_.fetch_add(1);
+        ended = true;
+      }
+      if (!ended) {
+        continue;
+      }
+
+      Color winner = sr.black_score > sr.white_score   ? Color::Black
+                     : sr.white_score > sr.black_score ? Color::White
+                                                       : Color::Empty;
+      finish(g, winner);
+    }
+  }
+}
+
+double Pipeline::train_step(torch::optim::Optimizer &optimizer,
+                            std::mt19937 &rng) {
+  auto [encodings, policies, values] =
+      buffer_.sample(trainer_.batch_size, rng);
+  auto [logits, value] = model_->forward(encodings);
+  auto policy_loss =
+      -(policies * torch::log_softmax(logits, 1)).sum(1).mean();
+  auto value_loss = torch::mse_loss(value.squeeze(1), values);
+  auto loss = policy_loss + value_loss;
+
+  optimizer.zero_grad();
+  loss.backward();
+  optimizer.step();
+  return loss.item<double>();
+}
+
+void Pipeline::run(int generations, const GenerationCallback &on_generation) {
+  torch::set_num_threads(trainer_.intra_op_threads);
+  std::mt19937 rng(std::random_device{}());
+  torch::optim::SGD optimizer(
+      model_->parameters(),
+      torch::optim::SGDOptions(trainer_.learning_rate)
+          .momentum(trainer_.momentum)
+          .weight_decay(trainer_.weight_decay));
+
+  start_workers();
+  for (int gen = 0; gen < generations; ++gen) {
+    while (buffer_.size() < trainer_.min_samples) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    model_->train();
+    double loss_sum = 0.0;
+    for (int step = 0; step < trainer_.steps_per_generation; ++step) {
+      loss_sum += train_step(optimizer, rng);
+    }
+    last_loss_ = loss_sum / std::max(1, trainer_.steps_per_generation);
+    model_->eval();
+
+    slot_.publish(*model_);
+    if (on_generation) {
+      on_generation(stats(), *model_);
+    }
+  }
+  stop_workers();
+}
+
+PipelineStats Pipeline::stats() const {
+  PipelineStats s;
+  s.generation = slot_.generation();
+  s.games = games_.load();
+  s.samples = buffer_.total_added();
+  s.loss = last_loss_;
+  s.resigned = resigned_.load();
+  s.adjudicated = adjudicated_.load();
+  s.resign_checked = resign_checked_.load();
+  s.resign_false_positives = resign_false_positives_.load();
+  return s;
+}
+
+} // namespace double_go
@@ -0,0 +1,311 @@
+#include "double-go/sgf.h"
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+
+namespace double_go {
+
+namespace {
+
+constexpr int END = std::char_traits<char>::eof();
+
+char phase_code(Phase p) {
+  switch (p) {
+  case Phase::First:
+    return '1';
+  case Phase::Second:
+    return '2';
+  case Phase::Bonus:
+    return 'b';
+  }
+  return '?';
+}
+
+std::string format_result(const Board &board, double komi) {
+  auto sr = board.score(komi);
+  double margin = sr.black_score - sr.white_score;
+  if (margin == 0)
+    return "0";
+  char buf[32];
+  double points = margin > 0 ? margin : -margin;
+  if (points == static_cast<int>(points))
+    std::snprintf(buf, sizeof(buf), "%c+%d", margin > 0 ? 'B' : 'W',
+                  static_cast<int>(points));
+  else
+    std::snprintf(buf, sizeof(buf), "%c+%.1f", margin > 0 ? 'B' : 'W',
+                  points);
+  return buf;
+}
+
+} // namespace
+
+// ── SgfReader ───────────────────────────────────────────────────────────────
+
+SgfReader::SgfReader(std::istream &in, std::string name)
+    : buf_(in.rdbuf()), name_(std::move(name)) {}
+
+int SgfReader::peek() { return buf_->sgetc(); }
+
+int SgfReader::get() {
+  int c = buf_->sbumpc();
+  if (c == '\n')
+    line_++;
+  return c;
+}
+
+int SgfReader::skip_space() {
+  int c;
+  while ((c = peek()) != END && std::isspace(c))
+    get();
+  return c;
+}
+
+void SgfReader::expect(char c) {
+  if (skip_space() != c)
+    fail(std::string("expected '") + c + "'");
+  get();
+}
+
+void SgfReader::fail(const std::string &what) const {
+  throw std::runtime_error(name_ + ":" + std::to_string(line_) + ": " + what);
+}
+
+bool SgfReader::next(SgfGame &game) {
+  if (skip_space() == END)
+    return false;
+  game.board_size = 19;
+  game.komi = 6.5;
+  game.result.clear();
+  game.actions.clear();
+  started_ = false;
+  read_tree(game);
+  return true;
+}
+
+void SgfReader::read_tree(SgfGame &game) {
+  // Descend through the first variation at every level, then climb back
+  // out skipping the others. Iterative, since some writers nest a
+  // variation per move.
+  expect('(');
+  int depth = 1;
+  for (;;) {
+    int c;
+    while ((c = skip_space()) == ';') {
+      get();
+      read_node(game);
+    }
+    if (c != '(')
+      break;
+    get();
+    depth++;
+  }
+  for (; depth > 0; depth--) {
+    while (skip_space() == '(')
+      skip_tree();
+    expect(')');
+  }
+}
+
+void SgfReader::skip_tree() {
+  expect('(');
+  for (int depth = 1; depth > 0;) {
+    int c = get();
+    if (c == END)
+      fail("unterminated game tree");
+    if (c == '[')
+      read_value(value_);
+    else if (c == '(')
+      depth++;
+    else if (c == ')')
+      depth--;
+  }
+}
+
+// After the opening bracket: the value up to the closing one, unescaped.
+void SgfReader::read_value(std::string &value) {
+  value.clear();
+  for (;;) {
+    int c = get();
+    if (c == END)
+      fail("unterminated property value");
+    if (c == ']')
+      return;
+    if (c == '\\') {
+      c = get();
+      if (c == END)
+        fail("unterminated property value");
+    }
+    value.push_back(static_cast<char>(c));
+  }
+}
+
+void SgfReader::read_node(SgfGame &game) {
+  std::optional<Action> move;
+  Color mover = Color::Empty;
+  std::optional<Phase> phase;
+
+  for (;;) {
+    int c = skip_space();
+    if (c == END || !std::isalpha(c))
+      break;
+    ident_.clear();
+    while ((c = peek()) != END && std::isalpha(c)) {
+      // FF[3] allows lowercase letters in identifiers; they carry nothing.
+      if (std::isupper(c))
+        ident_.push_back(static_cast<char>(c));
+      get();
+    }
+    if (skip_space() != '[')
+      fail("property " + ident_ + " without a value");
+    if (ident_ == "AB" || ident_ == "AW" || ident_ == "AE")
+      fail("setup properties are not supported");
+
+    while (skip_space() == '[') {
+      get();
+      read_value(value_);
+      if (ident_ == "SZ") {
+        char *end = nullptr;
+        long size = std::strtol(value_.c_str(), &end, 10);
+        if (*end != '\0' || size < 1 || size > 19)
+          fail("unsupported board size " + value_);
+        if (started_)
+          fail("SZ after the first move");
+        game.board_size = static_cast<int>(size);
+      } else if (ident_ == "KM") {
+        char *end = nullptr;
+        game.komi = std::strtod(value_.c_str(), &end);
+        if (value_.empty() || *end != '\0')
+          fail("malformed komi " + value_);
+      } else if (ident_ == "RE") {
+        game.result = value_;
+      } else if (ident_ == "B" || ident_ == "W") {
+        if (move)
+          fail("two moves in one node");
+        mover = ident_ == "B" ? Color::Black : Color::White;
+        int size = game.board_size;
+        if (value_.empty() || value_ == "tt") {
+          move = Action::pass();
+        } else if (value_.size() == 2 && value_[0] >= 'a' &&
+                   value_[0] < 'a' + size && value_[1] >= 'a' &&
+                   value_[1] < 'a' + size) {
+          move = Action::place({value_[1] - 'a', value_[0] - 'a'});
+        } else {
+          fail("bad move " + value_);
+        }
+      } else if (ident_ == "PH") {
+        if (value_ == "1")
+          phase = Phase::First;
+        else if (value_ == "2")
+          phase = Phase::Second;
+        else if (value_ == "b")
+          phase = Phase::Bonus;
+        else
+          fail("bad phase " + value_);
+      }
+    }
+  }
+
+  if (!move) {
+    if (phase)
+      fail("PH without a move");
+    return;
+  }
+  if (!started_) {
+    board_ = Board(game.board_size);
+    started_ = true;
+  }
+  int number = static_cast<int>(game.actions.size()) + 1;
+  if (board_.game_over())
+    fail("move " + std::to_string(number) + " after the end of the game");
+  if (mover != board_.to_play())
+    fail("move " + std::to_string(number) + " by the wrong color");
+  if (phase && *phase != board_.phase())
+    fail("move " + std::to_string(number) + " in the wrong phase");
+  if (!board_.apply(*move))
+    fail("illegal move " + std::to_string(number));
+  game.actions.push_back(*move);
+}
+
+// ── SgfWriter ───────────────────────────────────────────────────────────────
+
+void SgfWriter::write(const SgfGame &game) {
+  write(game.board_size, game.komi, game.result, game.actions);
+}
+
+void SgfWriter::write(const GameRecord &record) {
+  const Board &last = record.final_position();
+  write(record.board_size(), record.komi(),
+        last.game_over() ? format_result(last, record.komi()) : "",
+        record.actions());
+}
+
+void SgfWriter::write(int board_size, double komi, const std::string &result,
+                      const std::vector<Action> &actions) {
+  constexpr int NODES_PER_LINE = 8;
+  char number[32];
+  std::snprintf(number, sizeof(number), "%g", komi);
+  text_.assign("(;GM[1]FF[4]CA[UTF-8]AP[double-go]SZ[");
+  text_ += std::to_string(board_size);
+  text_ += "]KM[";
+  text_ += number;
+  text_ += ']';
+  if (!result.empty()) {
+    text_ += "RE[";
+    for (char c : result) {
+      if (c == ']' || c == '\\')
+        text_ += '\\';
+      text_ += c;
+    }
+    text_ += ']';
+  }
+
+  Board board(board_size);
+  for (size_t i = 0; i < actions.size(); i++) {
+    Action a = actions[i];
+    Color mover = board.to_play();
+    Phase phase = board.phase();
+    if (!board.apply(a))
+      throw std::runtime_error("sgf: illegal action at move " +
+                               std::to_string(i + 1));
+    text_ += i % NODES_PER_LINE == 0 ? "\n;" : ";";
+    text_ += mover == Color::Black ? "B[" : "W[";
+    if (a.type == ActionType::Place) {
+      text_ += static_cast<char>('a' + a.point.col);
+      text_ += static_cast<char>('a' + a.point.row);
+    }
+    text_ += "]PH[";
+    text_ += phase_code(phase);
+    text_ += ']';
+  }
+  text_ += ")\n";
+  out_.write(text_.data(), static_cast<std::streamsize>(text_.size()));
+}
+
+// ── GameRecord conversions ──────────────────────────────────────────────────
+
+GameRecord make_record(const SgfGame &game) {
+  GameRecord record(game.board_size, game.komi);
+  for (size_t i = 0; i < game.actions.size(); i++)
+    if (!record.add(game.actions[i]))
+      throw std::runtime_error("sgf: illegal action at move " +
+                               std::to_string(i + 1));
+  return record;
+}
+
+std::vector<GameRecord> load_sgf(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in)
+    throw std::runtime_error(path + ": cannot open");
+  SgfReader reader(in, path);
+  SgfGame game;
+  std::vector<GameRecord> records;
+  while (reader.next(game))
+    records.push_back(make_record(game));
+  return records;
+}
+
+} // namespace double_go
@@ -0,0 +1,138 @@
+#include "double-go/time_manager.h"
+
+#include <algorithm>
+
+namespace double_go {
+
+// ── Clocks ──────────────────────────────────────────────────────────────────
+
+ClockState initial_clock(const TimeControl &tc) {
+  if (tc.main_time > 0)
+    return {tc.main_time, 0};
+  return {tc.byo_yomi_time, tc.byo_yomi_stones};
+}
+
+ClockState charge(ClockState clock, const TimeControl &tc, double seconds) {
+  clock.seconds -= seconds;
+  if (clock.stones == 0) {
+    if (clock.seconds > 0 || tc.byo_yomi_stones <= 0)
+      return {std::max(0.0, clock.seconds), 0};
+    // The overrun comes out of the first period.
+    return {std::max(0.0, tc.byo_yomi_time + clock.seconds),
+            tc.byo_yomi_stones};
+  }
+  if (--clock.stones == 0)
+    return {tc.byo_yomi_time, tc.byo_yomi_stones};
+  clock.seconds = std::max(0.0, clock.seconds);
+  return clock;
+}
+
+// ── TimeManager ─────────────────────────────────────────────────────────────
+
+TimeManager::TimeManager(TimeConfig config) : config_(config) {}
+
+double TimeManager::weight(Phase phase) const {
+  switch (phase) {
+  case Phase::First:
+    return config_.first_weight;
+  case Phase::Second:
+    return config_.second_weight;
+  case Phase::Bonus:
+    return config_.bonus_weight;
+  }
+  return config_.first_weight;
+}
+
+TimeBudget TimeManager::allocate(const Board &board, const TimeControl &tc,
+                                 ClockState clock) const {
+  if (tc.unlimited())
+    return {};
+  // Bonus stones are rare enough to leave out of the average.
+  double share = weight(board.phase()) /
+                 ((config_.first_weight + config_.second_weight) / 2);
+
+  double stones_to_go;
+  if (clock.stones > 0) {
+    stones_to_go = clock.stones;
+  } else {
+    int empty = 0;
+    for (int row = 0; row < board.size(); row++)
+      for (int col = 0; col < board.size(); col++)
+        empty += board.at({row, col}) == Color::Empty;
+    stones_to_go = std::max<double>(config_.min_stones_to_go,
+                                    empty * config_.stones_per_empty);
+  }
+  double seconds =
+      std::max(0.0, clock.seconds - config_.overhead * stones_to_go);
+  double even = seconds / stones_to_go;
+
+  TimeBudget budget;
+  budget.target = even * share;
+  if (clock.stones > 0) {
+    // Leave the period's other stones at least half an even share each.
+    budget.maximum = seconds - (stones_to_go - 1) * even / 2;
+  } else {
+    budget.maximum = seconds * config_.max_share;
+    // Byo-yomi follows main time, so main time need not outlast its
+    // per-stone rate.
+    if (tc.byo_yomi_stones > 0) {
+      double period = std::max(0.0, tc.byo_yomi_time / tc.byo_yomi_stones -
+                                        config_.overhead);
+      budget.target = std::max(budget.target, period * share);
+      budget.maximum = std::max(budget.maximum, period);
+    }
+  }
+  budget.maximum =
+      std::min(budget.maximum, budget.target * config_.max_extension);
+  budget.target = std::min(budget.target, budget.maximum);
+  return budget;
+}
+
+void TimeManager::start(TimeBudget budget) {
+  budget_ = budget;
+  best_ = -1;
+  changed_at_ = 0.0;
+  mid_q_.reset();
+  extended_ = false;
+  stop_ = Stop::None;
+}
+
+bool TimeManager::should_stop(const SearchProgress &progress,
+                              double elapsed) {
+  if (progress.best != best_) {
+    best_ = progress.best;
+    changed_at_ = elapsed;
+  }
+  if (!mid_q_ && elapsed >= budget_.target / 2)
+    mid_q_ = progress.best_q;
+
+  if (progress.children <= 1) {
+    stop_ = Stop::Decided;
+    return true;
+  }
+  if (!extended_ && elapsed >= budget_.target) {
+    bool unstable = changed_at_ > budget_.target / 2 ||
+                    progress.best_q < *mid_q_ - config_.value_drop;
+    if (!unstable || budget_.maximum <= budget_.target) {
+      stop_ = Stop::Target;
+      return true;
+    }
+    extended_ = true;
+  }
+  double limit = extended_ ? budget_.maximum : budget_.target;
+  if (elapsed >= limit) {
+    stop_ = Stop::Maximum;
+    return true;
+  }
+  // At the rate so far, could the runner-up still catch up?
+  if (elapsed > 0) {
+    double remaining = progress.visits / elapsed * (limit - elapsed);
+    if (progress.best_visits - progress.second_visits > remaining) {
+      stop_ = Stop::Decided;
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace double_go
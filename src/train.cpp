@@ -0,0 +1,118 @@
+#include "double-go/checkpoint.h"
+#include "double-go/selfplay.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+namespace {
+
+void usage(const char *prog) {
+  std::fprintf(stderr,
+               "usage: %s [--size N] [--blocks N] [--channels N]\n"
+               "          [--workers N] [--games-per-batch N]\n"
+               "          [--generations N] [--steps N] [--batch N]\n"
+               "          [--lr X] [--komi X] [--out DIR]\n"
+               "          [--resign THRESHOLD] [--resign-disabled FRACTION]\n"
+               "          [--adjudicate MOVES,MARGIN] [--resume CHECKPOINT]\n"
+               "          [--record FILE] [--search VISITS]\n"
+               "Self-play moves come from a Gumbel search of VISITS\n"
+               "simulations (default 32; 16 to 64 suffice) and the policy\n"
+               "trains on its improved policy. --search 0 samples moves from\n"
+               "the raw policy and trains the value head only.\n",
+               prog);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  int size = 9;
+  int blocks = 6;
+  int channels = 64;
+  int generations = 100;
+  std::string out_dir = "checkpoints";
+  std::string resume;
+  double_go::SelfPlayConfig self_play;
+  double_go::TrainerConfig trainer;
+
+  for (int i = 1; i < argc; ++i) {
+    auto flag = [&](const char *name) {
+      return std::strcmp(argv[i], name) == 0 && i + 1 < argc;
+    };
+    if (flag("--size")) {
+      size = std::atoi(argv[++i]);
+    } else if (flag("--blocks")) {
+      blocks = std::atoi(argv[++i]);
+    } else if (flag("--channels")) {
+      channels = std::atoi(argv[++i]);
+    } else if (flag("--workers")) {
+      self_play.num_workers = std::atoi(argv[++i]);
+    } else if (flag("--games-per-batch")) {
+      self_play.games_per_batch = std::atoi(argv[++i]);
+    } else if (flag("--generations")) {
+      generations = std::atoi(argv[++i]);
+    } else if (flag("--steps")) {
+      trainer.steps_per_generation = std::atoi(argv[++i]);
+    } else if (flag("--batch")) {
+      trainer.batch_size = std::atoi(argv[++i]);
+    } else if (flag("--lr")) {
+      trainer.learning_rate = std::atof(argv[++i]);
+    } else if (flag("--komi")) {
+      self_play.komi = std::atof(argv[++i]);
+    } else if (flag("--resign")) {
+      self_play.resign_threshold = std::atof(argv[++i]);
+    } else if (flag("--resign-disabled")) {
+      self_play.resign_disabled_fraction = std::atof(argv[++i]);
+    } else if (flag("--adjudicate")) {
+      const char *arg = argv[++i];
+      const char *comma = std::strchr(arg, ',');
+      self_play.adjudicate_moves = std::atoi(arg);
+      if (comma)
+        self_play.adjudicate_margin = std::atof(comma + 1);
+    } else if (flag("--out")) {
+      out_dir = argv[++i];
+    } else if (flag("--resume")) {
+      resume = argv[++i];
+    } else if (flag("--record")) {
+      self_play.record_path = argv[++i];
+    } else if (flag("--search")) {
+      self_play.search_visits = std::atoi(argv[++i]);
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  std::filesystem::create_directories(out_dir);
+  std::shared_ptr<double_go::Model> model;
+  if (!resume.empty()) {
+    double_go::LoadOptions options;
+    options.fuse = false;
+    options.mmap = false;
+    model = double_go::load_checkpoint(resume, options);
+  } else {
+    model = std::make_shared<double_go::Model>(size, blocks, channels);
+  }
+  double_go::Pipeline pipeline(model, self_play, trainer);
+
+  pipeline.run(generations, [&](const double_go::PipelineStats &stats,
+                                const double_go::Model &trained) {
+    std::printf("gen %llu | games %llu | samples %llu | loss %.4f | "
+                "resigned %llu | adjudicated %llu | resign fp %.3f (%llu)\n",
+                static_cast<unsigned long long>(stats.generation),
+                static_cast<unsigned long long>(stats.games),
+                static_cast<unsigned long long>(stats.samples), stats.loss,
+                static_cast<unsigned long long>(stats.resigned),
+                static_cast<unsigned long long>(stats.adjudicated),
+                stats.resign_false_positive_rate(),
+                static_cast<unsigned long long>(stats.resign_checked));
+    std::fflush(stdout);
+
+    double_go::save_checkpoint(trained, out_dir + "/model_" +
+                                            std::to_string(stats.generation) +
+                                            ".dgc");
+  });
+  return 0;
+}
@@ -0,0 +1,100 @@
+#include "double-go/checkpoint.h"
+#include "double-go/policy_bot.h"
+#include "double-go/rollout.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+
+namespace {
+
+void usage(const char *prog) {
+  std::fprintf(stderr,
+               "usage: %s --teacher CHECKPOINT [--games N] [--lr X]\n"
+               "          [--temperature X] [--init WEIGHTS] [--out WEIGHTS]\n"
+               "          [--seed N]\n"
+               "Fits rollout weights to the moves the teacher plays in\n"
+               "self-play games.\n",
+               prog);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::string teacher_path, init_path, out_path = "rollout.dgr";
+  int games = 1000;
+  double learning_rate = 0.05;
+  double temperature = 1.0;
+  unsigned seed = 1;
+
+  for (int i = 1; i < argc; ++i) {
+    auto flag = [&](const char *name) {
+      return std::strcmp(argv[i], name) == 0 && i + 1 < argc;
+    };
+    if (flag("--teacher")) {
+      teacher_path = argv[++i];
+    } else if (flag("--games")) {
+      games = std::atoi(argv[++i]);
+    } else if (flag("--lr")) {
+      learning_rate = std::atof(argv[++i]);
+    } else if (flag("--temperature")) {
+      temperature = std::atof(argv[++i]);
+    } else if (flag("--init")) {
+      init_path = argv[++i];
+    } else if (flag("--out")) {
+      out_path = argv[++i];
+    } else if (flag("--seed")) {
+      seed = static_cast<unsigned>(std::atoll(argv[++i]));
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+  if (teacher_path.empty()) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  auto teacher = double_go::load_checkpoint(teacher_path);
+  double_go::PolicyBot bot(teacher, temperature, seed);
+  double_go::RolloutWeights weights =
+      init_path.empty() ? double_go::RolloutWeights::defaults()
+                        : double_go::RolloutWeights::load(init_path);
+  const int size = teacher->board_size;
+  const int max_moves = 4 * size * size;
+
+  double loss_sum = 0.0;
+  long long steps = 0;
+  for (int g = 1; g <= games; ++g) {
+    std::deque<double_go::Board> history{double_go::Board(size)};
+    for (int m = 0; m < max_moves && !history.back().game_over(); ++m) {
+      const double_go::Board &board = history.back();
+      double_go::Action action = bot.pick_action(history);
+      if (action.type == double_go::ActionType::Place) {
+        if (auto loss = weights.train_step(board, action.point,
+                                           learning_rate)) {
+          loss_sum += *loss;
+          ++steps;
+        }
+      }
+      double_go::Board next = board;
+      if (!next.apply(action))
+        next.apply(double_go::Action::pass());
+      history.push_back(std::move(next));
+      if (history.size() > double_go::Model::HISTORY_LEN)
+        history.pop_front();
+    }
+
+    if (g % 100 == 0 || g == games) {
+      std::printf("games %d | steps %lld | mean loss %.4f\n", g, steps,
+                  steps ? loss_sum / steps : 0.0);
+      std::fflush(stdout);
+      loss_sum = 0.0;
+      steps = 0;
+      weights.save(out_path);
+    }
+  }
+  return 0;
+}
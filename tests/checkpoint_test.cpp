@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include "double-go/checkpoint.h"
+
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+
+using namespace double_go;
+
+namespace {
+
+std::string temp_path(const char *name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+Tensor sample_input(Model &model) {
+  Board b(model.board_size);
+  b.apply(Action::place({2, 2}));
+  b.apply(Action::place({1, 3}));
+  std::deque<Board> history{Board(model.board_size), b};
+  return model.encode(history).unsqueeze(0);
+}
+
+} // namespace
+
+// ===== Metadata =====
+
+// Header records the architecture
+TEST(Checkpoint, InfoRecordsArchitecture) {
+  Model model(7, 2, 16);
+  auto path = temp_path("dg_info.dgc");
+  save_checkpoint(model, path);
+
+  auto info = read_checkpoint_info(path);
+  EXPECT_EQ(info.version, CHECKPOINT_VERSION);
+  EXPECT_EQ(info.board_size, 7);
+  EXPECT_EQ(info.num_blocks, 2);
+  EXPECT_EQ(info.num_channels, 16);
+  EXPECT_EQ(info.history_len, static_cast<int>(Model::HISTORY_LEN));
+  std::remove(path.c_str());
+}
+
+// ===== Round Trip =====
+
+// Unfused load reproduces parameters and batch norm statistics exactly
+TEST(Checkpoint, RoundTripExact) {
+  for (bool mmap : {true, false}) {
+    Model model(5, 1, 8);
+    // Give the batch norms non-trivial running statistics
+    model.train();
+    model.forward(torch::rand({4, Model::NUM_PLANES, 5, 5}));
+    model.eval();
+
+    auto path = temp_path("dg_roundtrip.dgc");
+    save_checkpoint(model, path);
+
+    LoadOptions options;
+    options.fuse = false;
+    options.mmap = mmap;
+    auto loaded = load_checkpoint(path, options);
+
+    auto expected = model.named_parameters();
+    for (const auto &p : loaded->named_parameters()) {
+      EXPECT_TRUE(torch::equal(p.value(), expected[p.key()])) << p.key();
+    }
+    auto expected_buffers = model.named_buffers();
+    for (const auto &b : loaded->named_buffers()) {
+      EXPECT_TRUE(torch::equal(b.value(), expected_buffers[b.key()]))
+          << b.key();
+    }
+    std::remove(path.c_str());
+  }
+}
+
+// Fused load matches the original model's eval-mode outputs
+TEST(Checkpoint, FusedLoadMatchesOutputs) {
+  Model model(5, 2, 8);
+  model.train();
+  model.forward(torch::rand({4, Model::NUM_PLANES, 5, 5}));
+  model.eval();
+
+  auto path = temp_path("dg_fused.dgc");
+  save_checkpoint(model, path);
+  auto loaded = load_checkpoint(path);
+  EXPECT_TRUE(loaded->is_fused());
+
+  torch::NoGradGuard no_grad;
+  auto input = sample_input(model);
+  auto [p1, v1] = model.forward(input);
+  auto [p2, v2] = loaded->forward(input);
+  EXPECT_TRUE(torch::allclose(p1, p2, 1e-4, 1e-5));
+  EXPECT_TRUE(torch::allclose(v1, v2, 1e-4, 1e-5));
+
+  // Fusing must not write back to the file (the mapping is read-only, so a
+  // write would fault)
+  auto reloaded = load_checkpoint(path, {.fuse = false, .mmap = true});
+  EXPECT_TRUE(torch::equal(reloaded->value_head->conv->weight,
+                           model.value_head->conv->weight));
+  std::remove(path.c_str());
+}
+
+// Fused models cannot be checkpointed
+TEST(Checkpoint, SaveFusedThrows) {
+  Model model(5, 1, 8);
+  model.fuse();
+  EXPECT_THROW(save_checkpoint(model, temp_path("dg_bad.dgc")),
+               std::invalid_argument);
+}
+
+// ===== Malformed Files =====
+
+// Wrong magic is rejected
+TEST(Checkpoint, BadMagicThrows) {
+  auto path = temp_path("dg_magic.dgc");
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << "definitely not a checkpoint, but long enough for a header";
+  }
+  EXPECT_THROW(read_checkpoint_info(path), std::runtime_error);
+  EXPECT_THROW(load_checkpoint(path), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+// Truncated data section is rejected
+TEST(Checkpoint, TruncatedThrows) {
+  Model model(5, 1, 8);
+  auto path = temp_path("dg_trunc.dgc");
+  save_checkpoint(model, path);
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+  EXPECT_THROW(load_checkpoint(path), std::runtime_error);
+  std::remove(path.c_str());
+}
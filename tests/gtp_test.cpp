@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include "double-go/gtp.h"
+
+#include <sstream>
+
+using namespace double_go;
+
+namespace {
+
+GtpEngine fast_engine(int size) {
+  GtpConfig config;
+  config.board_size = size;
+  config.search.visits = 16;
+  config.move_time = 0;
+  config.seed = 1;
+  return GtpEngine(config);
+}
+
+} // namespace
+
+// Columns skip I and rows count from the bottom
+TEST(Gtp, Vertices) {
+  EXPECT_EQ(parse_vertex("A1", 9), Action::place({8, 0}));
+  EXPECT_EQ(parse_vertex("j9", 9), Action::place({0, 8}));
+  EXPECT_EQ(parse_vertex("T19", 19), Action::place({0, 18}));
+  EXPECT_EQ(parse_vertex("PASS", 9), Action::pass());
+  for (const char *bad : {"I5", "K1", "A10", "A0", "A", "5A", "Z3"})
+    EXPECT_FALSE(parse_vertex(bad, 9).has_value()) << bad;
+  for (int idx = 0; idx <= 81; idx++) {
+    Action a = index_action(idx, 9);
+    EXPECT_EQ(parse_vertex(format_vertex(a, 9), 9), a);
+  }
+}
+
+// Responses carry the id, errors start with '?', and comments are ignored
+TEST(Gtp, ResponseFormat) {
+  GtpEngine engine = fast_engine(9);
+  EXPECT_EQ(engine.execute("1 protocol_version"), "=1 2\n\n");
+  EXPECT_EQ(engine.execute("name # comment"), "= double-go\n\n");
+  EXPECT_EQ(engine.execute("  # only a comment"), "");
+  EXPECT_EQ(engine.execute("7 frobnicate"), "?7 unknown command\n\n");
+  EXPECT_EQ(engine.execute("known_command dg-genturn"), "= true\n\n");
+  EXPECT_EQ(engine.execute("boardsize 25"), "? unacceptable size\n\n");
+}
+
+// Colors follow the Double Go turn: two stones, then the opponent, whose
+// answer to a double earns a bonus stone
+TEST(Gtp, PlayFollowsPhases) {
+  GtpEngine engine = fast_engine(9);
+  EXPECT_EQ(engine.execute("dg-phase"), "= black first\n\n");
+  EXPECT_EQ(engine.execute("play b D4"), "=\n\n");
+  EXPECT_EQ(engine.execute("dg-phase"), "= black second\n\n");
+  EXPECT_EQ(engine.execute("play w E5"), "? illegal move\n\n");
+  EXPECT_EQ(engine.execute("play b D4"), "? illegal move\n\n");
+  EXPECT_EQ(engine.execute("play b E5"), "=\n\n");
+  EXPECT_EQ(engine.execute("dg-phase"), "= white bonus\n\n");
+  EXPECT_EQ(engine.execute("genmove b"), "? not black's turn\n\n");
+
+  EXPECT_EQ(engine.execute("undo"), "=\n\n");
+  EXPECT_EQ(engine.execute("dg-phase"), "= black second\n\n");
+  EXPECT_EQ(engine.board().at({4, 4}), Color::Empty);
+  EXPECT_EQ(engine.board().at({5, 3}), Color::Black);
+}
+
+// genmove plays one legal stone; dg-genturn plays the rest of the turn
+TEST(Gtp, GenerateMoves) {
+  GtpEngine engine = fast_engine(7);
+  std::string move = engine.execute("genmove black");
+  ASSERT_EQ(move.substr(0, 2), "= ");
+  EXPECT_TRUE(parse_vertex(move.substr(2, move.size() - 4), 7).has_value());
+
+  for (int turn = 0; turn < 4 && !engine.board().game_over(); turn++) {
+    Color mover = engine.board().to_play();
+    std::string reply = engine.execute(
+        mover == Color::Black ? "dg-genturn b" : "dg-genturn w");
+    ASSERT_EQ(reply.substr(0, 2), "= ");
+    std::istringstream stones(reply.substr(2));
+    int count = 0;
+    for (std::string v; stones >> v; count++)
+      EXPECT_TRUE(parse_vertex(v, 7).has_value()) << v;
+    EXPECT_GE(count, 1);
+    EXPECT_LE(count, 3);
+    EXPECT_TRUE(engine.board().game_over() ||
+                engine.board().to_play() != mover);
+  }
+}
+
+// The engine answers a script until quit
+TEST(Gtp, RunsScript) {
+  GtpEngine engine = fast_engine(5);
+  std::istringstream in("komi 0.5\nplay b pass\nplay w pass\nfinal_score\n"
+                        "quit\nname\n");
+  std::ostringstream out;
+  engine.run(in, out);
+  EXPECT_EQ(out.str(), "=\n\n=\n\n=\n\n= W+0.5\n\n=\n\n");
+  EXPECT_TRUE(engine.quit_requested());
+}
+
+// Under a clock, generated stones are charged to the mover's clock and
+// time_left resets it
+TEST(Gtp, KeepsClock) {
+  GtpEngine engine = fast_engine(5);
+  EXPECT_EQ(engine.execute("time_settings 30 5 2"), "=\n\n");
+  EXPECT_EQ(engine.clock(Color::Black).seconds, 30);
+  ASSERT_EQ(engine.execute("genmove b").substr(0, 2), "= ");
+  EXPECT_LT(engine.clock(Color::Black).seconds, 30);
+  EXPECT_EQ(engine.clock(Color::White).seconds, 30);
+
+  EXPECT_EQ(engine.execute("time_left b 4 1"), "=\n\n");
+  EXPECT_EQ(engine.clock(Color::Black).stones, 1);
+  EXPECT_EQ(engine.execute("time_left x 4 1"), "? syntax error\n\n");
+}
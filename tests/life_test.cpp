@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include "double-go/double-go.h"
+#include "double-go/match.h"
+
+#include <string>
+#include <vector>
+
+using namespace double_go;
+
+namespace {
+
+// Sets up a position from rows of 'B', 'W' and '.', passing as needed so
+// each stone is played by its own color.
+Board from_rows(const std::vector<std::string> &rows) {
+  Board b(static_cast<int>(rows.size()));
+  for (int r = 0; r < b.size(); r++) {
+    for (int c = 0; c < b.size(); c++) {
+      if (rows[r][c] == '.')
+        continue;
+      Color color = rows[r][c] == 'B' ? Color::Black : Color::White;
+      if (b.to_play() != color)
+        b.pass();
+      EXPECT_TRUE(b.play_single({r, c})) << r << "," << c;
+    }
+  }
+  return b;
+}
+
+} // namespace
+
+// ===== Pass-Alive Analysis =====
+
+// Nothing is settled on an empty board
+TEST(Life, EmptyBoardUnsettled) {
+  Board b(9);
+  LifeStatus life = pass_alive(b);
+  EXPECT_EQ(life.black_points, 0);
+  EXPECT_EQ(life.white_points, 0);
+  EXPECT_FALSE(settled_winner(life, 6.5).has_value());
+}
+
+// A chain with two one-point eyes is pass-alive; the chain around it is not
+TEST(Life, TwoEyesAlive) {
+  Board b = from_rows({
+      ".B.BW",
+      "BBBBW",
+      "WWWWW",
+      ".....",
+      ".....",
+  });
+  LifeStatus life = pass_alive(b);
+  EXPECT_EQ(life.black_points, 8); // six stones and two eyes
+  EXPECT_EQ(life.white_points, 0);
+  EXPECT_EQ(life.owner[0 * 5 + 0], Color::Black);
+  EXPECT_EQ(life.owner[0 * 5 + 2], Color::Black);
+  EXPECT_EQ(life.owner[1 * 5 + 1], Color::Black);
+  EXPECT_EQ(life.owner[2 * 5 + 0], Color::Empty);
+}
+
+// A single eye is not enough
+TEST(Life, OneEyeNotAlive) {
+  Board b = from_rows({
+      ".BBBW",
+      "BBBBW",
+      "WWWWW",
+      ".....",
+      ".....",
+  });
+  LifeStatus life = pass_alive(b);
+  EXPECT_EQ(life.black_points, 0);
+}
+
+// Opponent stones inside pass-alive territory are dead
+TEST(Life, DeadStonesInTerritory) {
+  Board b = from_rows({
+      "W.B.B",
+      ".BBBB",
+      "BB...",
+      ".....",
+      ".....",
+  });
+  LifeStatus life = pass_alive(b);
+  // Eight stones, the three-point corner with its dead stone, one eye.
+  EXPECT_EQ(life.black_points, 12);
+  EXPECT_EQ(life.owner[0], Color::Black);
+
+  auto plain = b.score(0.0);
+  EXPECT_EQ(plain.white_stones, 1);
+  auto sr = score_pass_alive(b, life, 0.0);
+  EXPECT_EQ(sr.white_stones, 0);
+  EXPECT_DOUBLE_EQ(sr.black_score, 25.0);
+  EXPECT_DOUBLE_EQ(sr.white_score, 0.0);
+}
+
+// The winner is settled once open points cannot close the gap
+TEST(Life, SettledWinner) {
+  Board b = from_rows({
+      ".B.B.",
+      "BBBBB",
+      "BBBBB",
+      ".....",
+      ".....",
+  });
+  LifeStatus life = pass_alive(b);
+  EXPECT_EQ(life.black_points, 15);
+  EXPECT_EQ(settled_winner(life, 4.5), Color::Black);
+  // 15 vs 10 + 5.5: White could still win on the open points.
+  EXPECT_FALSE(settled_winner(life, 5.5).has_value());
+  // Komi alone exceeds everything Black could get.
+  EXPECT_EQ(settled_winner(pass_alive(Board(5)), 25.5), Color::White);
+}
+
+// ===== Dead-Stone Estimation =====
+
+// Playouts give the dead corner stone to Black and remove it from the score
+TEST(Life, EstimateOwnershipFindsDeadStone) {
+  Board b = from_rows({
+      "W.B.B",
+      ".BBBB",
+      "BB...",
+      ".....",
+      ".....",
+  });
+  std::mt19937 rng(1);
+  auto ownership = estimate_ownership(b, 200, rng);
+  ASSERT_EQ(ownership.size(), 25u);
+  EXPECT_GT(ownership[0], 0.5f);         // white stone, Black's in the end
+  EXPECT_GT(ownership[1 * 5 + 1], 0.9f); // pass-alive black stone
+
+  auto sr = score_with_dead_stones(b, ownership, 0.0);
+  EXPECT_EQ(sr.white_stones, 0);
+  EXPECT_GT(sr.black_score, sr.white_score);
+}
+
+// Playouts leave the shared superko history as they found it
+TEST(Life, EstimateOwnershipRollsBackSuperko) {
+  Board b(5);
+  b.enable_superko(SuperkoRule::Positional);
+  b.play_single({2, 2});
+  size_t before = b.position_history()->size();
+  std::mt19937 rng(2);
+  estimate_ownership(b, 20, rng);
+  EXPECT_EQ(b.position_history()->size(), before);
+}
+
+// ===== Early Termination =====
+
+// Settled games stop early and agree with a pass-alive scoring of the end
+TEST(Life, MatchStopsWhenSettled) {
+  MatchConfig config;
+  config.board_size = 7;
+  config.num_games = 40;
+  config.num_threads = 2;
+  config.seed = 5;
+  PlayerFactory random = [](unsigned seed, double) -> Player {
+    auto bot = std::make_shared<RandomBot>(seed);
+    return [bot](const std::deque<Board> &history) {
+      return bot->pick_action(history.back());
+    };
+  };
+
+  MatchSummary full, settled;
+  run_match(random, random, config, [&](const MatchGame &g) {
+    full.add(g);
+    return true;
+  });
+  config.stop_when_settled = true;
+  run_match(random, random, config, [&](const MatchGame &g) {
+    settled.add(g);
+    return true;
+  });
+  EXPECT_GT(settled.settled, 0);
+  EXPECT_LT(settled.total_moves(), full.total_moves());
+}
@@ -547,6 +547,56 @@ TEST(Scoring, ScoreWithKomi) {
   EXPECT_DOUBLE_EQ(sr2.white_score, 7.5);
 }
 
+// Territory by the definition: an empty point belongs to a color if every
+// stone reachable through empty points is that color.
+static int naive_territory(const Board &b, Color color) {
+  int n = b.size(), count = 0;
+  for (int i = 0; i < n * n; i++) {
+    if (b.at_index(i) != Color::Empty)
+      continue;
+    std::vector<bool> seen(n * n, false);
+    std::vector<int> stack{i};
+    seen[i] = true;
+    bool mine = false, theirs = false;
+    while (!stack.empty()) {
+      int idx = stack.back();
+      stack.pop_back();
+      int r = idx / n, c = idx % n;
+      int nbrs[4][2] = {{r - 1, c}, {r + 1, c}, {r, c - 1}, {r, c + 1}};
+      for (auto &q : nbrs) {
+        if (q[0] < 0 || q[0] >= n || q[1] < 0 || q[1] >= n)
+          continue;
+        int ni = q[0] * n + q[1];
+        Color nc = b.at_index(ni);
+        if (nc == Color::Empty && !seen[ni]) {
+          seen[ni] = true;
+          stack.push_back(ni);
+        } else if (nc == color) {
+          mine = true;
+        } else if (nc != Color::Empty) {
+          theirs = true;
+        }
+      }
+    }
+    count += mine && !theirs;
+  }
+  return count;
+}
+
+// Scoring agrees with the definition on positions from random games
+TEST(Scoring, MatchesDefinitionOnRandomGames) {
+  for (int size : {3, 5, 9, 19}) {
+    RandomBot bot(size);
+    Board b(size);
+    for (int n = 0; n < 4 * size * size && !b.game_over(); n++) {
+      b.apply(bot.pick_action(b));
+      auto sr = b.score(0.0);
+      ASSERT_EQ(sr.black_territory, naive_territory(b, Color::Black));
+      ASSERT_EQ(sr.white_territory, naive_territory(b, Color::White));
+    }
+  }
+}
+
 // Place is accepted even when no second move is possible (can pass instead)
 TEST(DoubleMove, PlaceAcceptedWhenNoSecondMove) {
   // 4x4 board with Black at (0,1) and (1,0), White everywhere else
@@ -780,3 +830,160 @@ TEST(DoubleMove, SingleMoveNoPenalty) {
   // White plays
   b.play_single({5, 5});
 }
+
+// ── Superko ─────────────────────────────────────────────────────────────────
+
+// Insert, lookup and duplicate insertion
+TEST(PositionHistory, InsertAndContains) {
+  PositionHistory h(4);
+  EXPECT_FALSE(h.contains(42));
+  h.insert(42);
+  h.insert(42);
+  h.insert(0);
+  EXPECT_TRUE(h.contains(42));
+  EXPECT_TRUE(h.contains(0));
+  EXPECT_EQ(h.size(), 2u);
+}
+
+// Rollback undoes insertions after the mark, across table growth
+TEST(PositionHistory, RollbackAcrossGrowth) {
+  PositionHistory h(4);
+  std::mt19937_64 rng(1);
+  std::vector<uint64_t> kept, dropped;
+  for (int i = 0; i < 10; i++) {
+    kept.push_back(rng());
+    h.insert(kept.back());
+  }
+  size_t mark = h.mark();
+  h.insert(kept[3]); // duplicate must survive the rollback
+  for (int i = 0; i < 1000; i++) {
+    dropped.push_back(rng());
+    h.insert(dropped.back());
+  }
+  h.rollback(mark);
+  EXPECT_EQ(h.size(), kept.size());
+  for (uint64_t k : kept)
+    EXPECT_TRUE(h.contains(k));
+  for (uint64_t k : dropped)
+    EXPECT_FALSE(h.contains(k));
+}
+
+// Builds a 4x4 position with a ko at (1,1)/(1,2): black to play captures
+// at (1,1), then white would recapture at (1,2).
+static Board ko_position(SuperkoRule rule) {
+  Board b(4);
+  b.enable_superko(rule);
+  b.play_single({0, 1}); // B
+  b.play_single({0, 2}); // W
+  b.play_single({1, 0}); // B
+  b.play_single({1, 3}); // W
+  b.play_single({2, 1}); // B
+  b.play_single({2, 2}); // W
+  b.pass();              // B
+  b.play_single({1, 1}); // W
+  return b;
+}
+
+// Superko off: a recorded position does not restrict moves
+TEST(Superko, DisabledByDefault) {
+  Board b(9);
+  EXPECT_EQ(b.superko_rule(), SuperkoRule::None);
+  EXPECT_EQ(b.position_history(), nullptr);
+}
+
+// The history tracks every placement, shared by copies of the board
+TEST(Superko, HistorySharedByCopies) {
+  Board b = ko_position(SuperkoRule::Positional);
+  Board copy = b;
+  EXPECT_EQ(copy.position_history(), b.position_history());
+  EXPECT_TRUE(b.position_history()->contains(b.stone_hash()));
+  size_t before = b.position_history()->size();
+  ASSERT_TRUE(copy.play_single({3, 3}));
+  EXPECT_EQ(b.position_history()->size(), before + 1);
+}
+
+// A move recreating an earlier stone arrangement is illegal
+TEST(Superko, PositionalRejectsRepeat) {
+  ZobristHash &z = ZobristHash::get_instance();
+  Board b = ko_position(SuperkoRule::Positional);
+  ASSERT_EQ(b.to_play(), Color::Black);
+  EXPECT_TRUE(b.is_legal({3, 3}));
+  EXPECT_TRUE(b.is_legal({1, 2}));
+
+  b.position_history()->insert(b.stone_hash() ^ z.stone(Color::Black, {3, 3}));
+  EXPECT_FALSE(b.is_legal({3, 3}));
+
+  // The capture at (1,2) also removes the white stone at (1,1).
+  b.position_history()->insert(b.stone_hash() ^
+                               z.stone(Color::Black, {1, 2}) ^
+                               z.stone(Color::White, {1, 1}));
+  EXPECT_FALSE(b.is_legal({1, 2}));
+  EXPECT_FALSE(b.apply(Action::place({1, 2})));
+}
+
+// Situational superko only forbids repeats by the same player
+TEST(Superko, SituationalDistinguishesMover) {
+  ZobristHash &z = ZobristHash::get_instance();
+  Board b = ko_position(SuperkoRule::Situational);
+  uint64_t after = b.stone_hash() ^ z.stone(Color::Black, {3, 3});
+  b.position_history()->insert(after); // as if white had made it
+  EXPECT_TRUE(b.is_legal({3, 3}));
+  b.position_history()->insert(after ^ z.black_move());
+  EXPECT_FALSE(b.is_legal({3, 3}));
+}
+
+// mark/rollback lets a hypothetical line be undone
+TEST(Superko, RollbackAfterExploration) {
+  Board b = ko_position(SuperkoRule::Positional);
+  auto history = b.position_history();
+  size_t mark = history->mark();
+  Board line = b;
+  ASSERT_TRUE(line.play_single({3, 3}));
+  uint64_t explored = line.stone_hash();
+  EXPECT_TRUE(history->contains(explored));
+  history->rollback(mark);
+  EXPECT_FALSE(history->contains(explored));
+  EXPECT_TRUE(b.is_legal({3, 3}));
+}
+
+// Plays into a double-ko cycle on 7x7: black takes ko A, white takes ko B,
+// black passes, white retakes A. Black retaking B at (5,1) would restore the
+// stones black left at the start of the cycle.
+static Board double_ko_cycle(SuperkoRule rule, uint64_t &start) {
+  Board b(7);
+  if (rule != SuperkoRule::None)
+    b.enable_superko(rule);
+  b.pass(); // B, so that black places the last setup stone
+  const Point setup[] = {
+      {0, 2}, {0, 1}, {1, 3}, {1, 0}, {2, 2}, {2, 1}, {1, 1}, // ko A
+      {4, 2}, {4, 1}, {5, 3}, {5, 0}, {6, 2}, {6, 1}, {5, 1}, // ko B
+  };
+  for (Point p : setup)
+    EXPECT_TRUE(b.play_single(p));
+  start = b.stone_hash();
+  b.pass();                            // W
+  EXPECT_TRUE(b.play_single({1, 2}));  // B takes A
+  EXPECT_TRUE(b.play_single({5, 2}));  // W takes B
+  b.pass();                            // B
+  EXPECT_TRUE(b.play_single({1, 1}));  // W retakes A
+  EXPECT_EQ(b.to_play(), Color::Black);
+  return b;
+}
+
+// A repetition reached by real play is rejected under either superko rule,
+// and allowed without one
+TEST(Superko, RejectsRepetitionCycle) {
+  uint64_t start;
+  for (SuperkoRule rule : {SuperkoRule::Positional, SuperkoRule::Situational}) {
+    Board b = double_ko_cycle(rule, start);
+    EXPECT_EQ(b.ko_point(), std::optional<Point>(Point{1, 2}));
+    EXPECT_FALSE(b.is_legal({5, 1}));
+    EXPECT_FALSE(b.apply(Action::place({5, 1})));
+    EXPECT_TRUE(b.is_legal({3, 3}));
+  }
+
+  Board b = double_ko_cycle(SuperkoRule::None, start);
+  EXPECT_TRUE(b.is_legal({5, 1}));
+  ASSERT_TRUE(b.apply(Action::place({5, 1})));
+  EXPECT_EQ(b.stone_hash(), start);
+}
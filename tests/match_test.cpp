@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+
+#include "double-go/double-go.h"
+#include "double-go/match.h"
+
+#include <memory>
+#include <set>
+
+using namespace double_go;
+
+namespace {
+
+PlayerFactory random_factory() {
+  return [](unsigned seed, double) -> Player {
+    auto bot = std::make_shared<RandomBot>(seed);
+    return [bot](const std::deque<Board> &history) {
+      return bot->pick_action(history.back());
+    };
+  };
+}
+
+Player always_pass() {
+  return [](const std::deque<Board> &) { return Action::pass(); };
+}
+
+} // namespace
+
+// ===== Single Games =====
+
+// Two passing players end the game immediately and komi decides it
+TEST(PlayGame, PassingGameWhiteWinsOnKomi) {
+  auto r = play_game(always_pass(), always_pass(), 9, 6.5, 100);
+  EXPECT_TRUE(r.finished);
+  EXPECT_EQ(r.num_moves, 2);
+  EXPECT_EQ(r.winner, Color::White);
+  EXPECT_DOUBLE_EQ(r.white_score, 6.5);
+}
+
+// Zero komi on an empty board is a draw
+TEST(PlayGame, DrawWithoutKomi) {
+  auto r = play_game(always_pass(), always_pass(), 9, 0.0, 100);
+  EXPECT_EQ(r.winner, Color::Empty);
+}
+
+// Move limit stops games that would not end
+TEST(PlayGame, MoveLimit) {
+  auto bot = std::make_shared<RandomBot>(1);
+  Player p = [bot](const std::deque<Board> &history) {
+    return bot->pick_action(history.back());
+  };
+  auto r = play_game(p, p, 9, 6.5, 10);
+  EXPECT_LE(r.num_moves, 10);
+}
+
+// Illegal actions are played as passes
+TEST(PlayGame, IllegalActionBecomesPass) {
+  Player occupied = [](const std::deque<Board> &) {
+    return Action::place({0, 0});
+  };
+  // Black places at (0,0) then keeps trying to; every retry is a pass
+  auto r = play_game(occupied, always_pass(), 5, 0.5, 20);
+  EXPECT_TRUE(r.finished);
+  EXPECT_EQ(r.black_score, 25);
+}
+
+// ===== Matches =====
+
+// Every game is reported once with alternating colors
+TEST(RunMatch, ReportsAllGames) {
+  MatchConfig config;
+  config.board_size = 5;
+  config.num_games = 12;
+  config.num_threads = 3;
+  config.max_moves = 60;
+  config.komis = {0.5, 7.5};
+  config.seed = 42;
+
+  std::set<int> seen;
+  int a_black = 0;
+  run_match(random_factory(), random_factory(), config,
+            [&](const MatchGame &g) {
+              EXPECT_TRUE(seen.insert(g.index).second);
+              EXPECT_EQ(g.a_is_black, g.index % 2 == 0);
+              EXPECT_DOUBLE_EQ(g.komi, g.index / 2 % 2 == 0 ? 0.5 : 7.5);
+              a_black += g.a_is_black;
+              return true;
+            });
+  EXPECT_EQ(seen.size(), 12u);
+  EXPECT_EQ(a_black, 6);
+}
+
+// Returning false from the callback stops the match
+TEST(RunMatch, EarlyStop) {
+  MatchConfig config;
+  config.board_size = 5;
+  config.num_games = 1000;
+  config.num_threads = 4;
+  config.max_moves = 60;
+
+  int reported = 0;
+  run_match(random_factory(), random_factory(), config,
+            [&](const MatchGame &) { return ++reported < 5; });
+  EXPECT_EQ(reported, 5);
+}
+
+// ===== Statistics =====
+
+// Wilson interval contains the point estimate and narrows with more games
+TEST(MatchStats, WilsonInterval) {
+  auto small = win_rate(6, 0, 4);
+  auto large = win_rate(600, 0, 400);
+  EXPECT_DOUBLE_EQ(small.score, 0.6);
+  EXPECT_DOUBLE_EQ(large.score, 0.6);
+  EXPECT_LT(small.lower, 0.6);
+  EXPECT_GT(small.upper, 0.6);
+  EXPECT_LT(large.upper - large.lower, small.upper - small.lower);
+  EXPECT_NEAR(large.lower, 0.569, 0.002);
+  EXPECT_NEAR(large.upper, 0.630, 0.002);
+}
+
+// Draws count as half a win
+TEST(MatchStats, DrawsCountHalf) {
+  EXPECT_DOUBLE_EQ(win_rate(0, 10, 0).score, 0.5);
+}
+
+// Elo conversion is zero at an even score and antisymmetric
+TEST(MatchStats, ScoreToElo) {
+  EXPECT_DOUBLE_EQ(score_to_elo(0.5), 0.0);
+  EXPECT_NEAR(score_to_elo(0.75), 190.8, 0.1);
+  EXPECT_NEAR(score_to_elo(0.25), -score_to_elo(0.75), 1e-9);
+}
+
+// A dominant player is accepted quickly, a weak one rejected
+TEST(Sprt, AcceptsAndRejects) {
+  Sprt strong(0, 20);
+  int games = 0;
+  while (strong.status() == Sprt::Status::Continue && games < 1000) {
+    strong.add(games % 10 == 9 ? 0.0 : 1.0);
+    ++games;
+  }
+  EXPECT_EQ(strong.status(), Sprt::Status::AcceptH1);
+  EXPECT_LT(games, 100);
+
+  Sprt weak(0, 20);
+  games = 0;
+  while (weak.status() == Sprt::Status::Continue && games < 1000) {
+    weak.add(games % 10 < 6 ? 0.0 : 1.0);
+    ++games;
+  }
+  EXPECT_EQ(weak.status(), Sprt::Status::AcceptH0);
+}
+
+// A single game never decides the test
+TEST(Sprt, OneGameContinues) {
+  Sprt s(0, 20);
+  s.add(1.0);
+  EXPECT_EQ(s.status(), Sprt::Status::Continue);
+}
+
+// Summary tallies results, margins and lengths from a's point of view
+TEST(MatchSummary, Tallies) {
+  MatchSummary s;
+  auto result = [](Color winner, double black, double white, int moves,
+                   bool finished) {
+    return GameResult{.winner = winner,
+                      .black_score = black,
+                      .white_score = white,
+                      .num_moves = moves,
+                      .finished = finished,
+                      .settled = false,
+                      .actions = {}};
+  };
+  MatchGame g{0, true, 6.5, result(Color::Black, 20, 10.5, 30, true)};
+  s.add(g); // a black, wins by 9.5
+  g = {1, false, 6.5, result(Color::Black, 20, 10.5, 50, false)};
+  s.add(g); // a white, loses by 9.5
+  g = {2, true, 0.0, result(Color::Empty, 10, 10, 10, true)};
+  s.add(g); // draw
+
+  EXPECT_EQ(s.wins, 1);
+  EXPECT_EQ(s.losses, 1);
+  EXPECT_EQ(s.draws, 1);
+  EXPECT_EQ(s.games_as_black, 2);
+  EXPECT_EQ(s.wins_as_black, 1);
+  EXPECT_EQ(s.unfinished, 1);
+  EXPECT_EQ(s.total_moves(), 90);
+  EXPECT_DOUBLE_EQ(s.mean_margin(), 0.0);
+  EXPECT_DOUBLE_EQ(s.margin_stddev(), 9.5);
+  EXPECT_EQ(s.length_percentile(0.5), 30);
+  EXPECT_EQ(s.length_percentile(1.0), 50);
+  EXPECT_EQ(s.length_percentile(0.0), 10);
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include "double-go/double-go.h"
+#include "double-go/patterns.h"
+
+#include <random>
+
+using namespace double_go;
+
+namespace {
+
+PatternCode make_code(std::initializer_list<int> fields) {
+  PatternCode code = 0;
+  int slot = 0;
+  for (int f : fields)
+    code |= static_cast<PatternCode>(f) << (2 * slot++);
+  return code;
+}
+
+// Compares incremental features against a PatternBoard built from scratch.
+void expect_matches_fresh(const PatternBoard &pb) {
+  PatternBoard fresh(pb.board());
+  int n = pb.size() * pb.size();
+  for (int i = 0; i < n; i++) {
+    ASSERT_EQ(pb.pattern(i), fresh.pattern(i)) << "point " << i;
+    for (Color c : {Color::Black, Color::White}) {
+      ASSERT_EQ(pb.captures(i, c), fresh.captures(i, c)) << "point " << i;
+      ASSERT_EQ(pb.extends_atari(i, c), fresh.extends_atari(i, c))
+          << "point " << i;
+    }
+  }
+}
+
+} // namespace
+
+// ===== Pattern Codes =====
+
+// Corner and center codes on an empty board
+TEST(Patterns, EmptyBoardCodes) {
+  PatternBoard pb{Board(5)};
+  // (0,0): N, W, NE, SW, NW off the board
+  EXPECT_EQ(pb.pattern(0), make_code({3, 0, 0, 3, 3, 0, 3, 3}));
+  EXPECT_EQ(pb.pattern(2 * 5 + 2), 0);
+}
+
+// Placing a stone updates its neighbours' codes and marks them dirty
+TEST(Patterns, PlacementUpdatesNeighbours) {
+  PatternBoard pb{Board(5)};
+  ASSERT_TRUE(pb.apply(Action::place({2, 2})));
+  // (1,2) sees the black stone to its south
+  EXPECT_EQ(pb.pattern(1 * 5 + 2), make_code({0, 0, 1, 0, 0, 0, 0, 0}));
+  // (1,1) sees it to its south-east
+  EXPECT_EQ(pb.pattern(1 * 5 + 1), make_code({0, 0, 0, 0, 0, 1, 0, 0}));
+  EXPECT_EQ(pb.dirty().size(), 9u);
+}
+
+// Black and white swap, everything else stays
+TEST(Patterns, SwapColors) {
+  PatternCode code = make_code({1, 2, 0, 3, 2, 1, 3, 0});
+  EXPECT_EQ(swap_colors(code), make_code({2, 1, 0, 3, 1, 2, 3, 0}));
+  EXPECT_EQ(swap_colors(swap_colors(code)), code);
+}
+
+// ===== Eyes =====
+
+// Eye shapes in the center and on the edge
+TEST(Patterns, EyeTable) {
+  // Surrounded by black, one white diagonal: still an eye in the center
+  EXPECT_TRUE(is_eye_pattern(make_code({1, 1, 1, 1, 2, 0, 0, 0}),
+                             Color::Black));
+  // Two white diagonals: false eye
+  EXPECT_FALSE(is_eye_pattern(make_code({1, 1, 1, 1, 2, 2, 0, 0}),
+                              Color::Black));
+  // On the edge a single white diagonal makes it false
+  EXPECT_TRUE(is_eye_pattern(make_code({3, 1, 1, 1, 3, 0, 0, 3}),
+                             Color::Black));
+  EXPECT_FALSE(is_eye_pattern(make_code({3, 1, 1, 1, 3, 2, 0, 3}),
+                              Color::Black));
+  // An empty orthogonal neighbour means no eye, for either color
+  EXPECT_FALSE(is_eye_pattern(make_code({1, 1, 0, 1, 0, 0, 0, 0}),
+                              Color::Black));
+  EXPECT_TRUE(is_eye_pattern(make_code({2, 2, 2, 2, 0, 0, 0, 0}),
+                             Color::White));
+  EXPECT_FALSE(is_eye_pattern(make_code({2, 2, 2, 2, 0, 0, 0, 0}),
+                              Color::Black));
+}
+
+// ===== Atari =====
+
+// Capture and extension flags on the last liberty of a group
+TEST(Patterns, AtariFlags) {
+  Board b(5);
+  b.play_single({0, 1}); // B
+  b.play_single({0, 0}); // W in the corner, one liberty left at (1,0)
+  PatternBoard pb(b);
+  int lib = 1 * 5 + 0;
+  EXPECT_TRUE(pb.captures(lib, Color::Black));
+  EXPECT_TRUE(pb.extends_atari(lib, Color::White));
+  EXPECT_FALSE(pb.captures(lib, Color::White));
+
+  ASSERT_TRUE(pb.apply(Action::place({1, 0}))); // B captures
+  EXPECT_EQ(pb.board().at({0, 0}), Color::Empty);
+  EXPECT_FALSE(pb.captures(lib, Color::Black));
+  expect_matches_fresh(pb);
+}
+
+// Playing into a spot with one liberty and no capture is self-atari
+TEST(Patterns, SelfAtari) {
+  Board b(5);
+  b.play_single({0, 1}); // B
+  b.pass();              // W
+  b.play_single({1, 1}); // B
+  b.pass();              // W
+  PatternBoard pb(b);
+  // White at (0,0) would have one liberty, (1,0)
+  EXPECT_TRUE(pb.is_self_atari(0, Color::White));
+  EXPECT_FALSE(pb.is_self_atari(0, Color::Black));
+  EXPECT_FALSE(pb.is_self_atari(2 * 5 + 2, Color::White));
+}
+
+// Incremental features agree with a fresh computation through random games
+TEST(Patterns, RandomGamesMatchFresh) {
+  for (int size : {5, 9}) {
+    std::mt19937 rng(size);
+    PatternBoard pb{Board(size)};
+    for (int n = 0; n < 3 * size * size && !pb.board().game_over(); n++) {
+      auto actions = pb.board().legal_actions();
+      ASSERT_TRUE(pb.apply(actions[rng() % actions.size()]));
+      expect_matches_fresh(pb);
+    }
+  }
+}
+
+// Points left out of dirty() keep all their features
+TEST(Patterns, DirtyCoversChanges) {
+  struct Features {
+    PatternCode code;
+    bool flags[6];
+    bool operator==(const Features &) const = default;
+  };
+  auto features = [](const PatternBoard &pb, int i) {
+    Features f{pb.pattern(i), {}};
+    int k = 0;
+    for (Color c : {Color::Black, Color::White}) {
+      f.flags[k++] = pb.captures(i, c);
+      f.flags[k++] = pb.extends_atari(i, c);
+      f.flags[k++] = pb.board().at_index(i) == Color::Empty &&
+                     pb.is_self_atari(i, c);
+    }
+    return f;
+  };
+
+  std::mt19937 rng(3);
+  PatternBoard pb{Board(7)};
+  int n = 49;
+  for (int m = 0; m < 150 && !pb.board().game_over(); m++) {
+    std::vector<Features> before;
+    for (int i = 0; i < n; i++)
+      before.push_back(features(pb, i));
+    auto actions = pb.board().legal_actions();
+    ASSERT_TRUE(pb.apply(actions[rng() % actions.size()]));
+    std::vector<bool> dirty(n, false);
+    for (int i : pb.dirty())
+      dirty[i] = true;
+    for (int i = 0; i < n; i++) {
+      if (dirty[i])
+        continue;
+      ASSERT_EQ(features(pb, i), before[i]) << "move " << m << " point " << i;
+    }
+  }
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include "double-go/double-go.h"
+#include "double-go/record.h"
+
+#include <sstream>
+#include <stdexcept>
+
+using namespace double_go;
+
+namespace {
+
+// A random game of the given length on a 9x9 board, with a short keyframe
+// interval so seeks cross several keyframes.
+GameRecord random_game(int moves, int interval) {
+  GameRecord record(9, 6.5, interval);
+  RandomBot bot(11);
+  for (int i = 0; i < moves && !record.final_position().game_over(); i++)
+    EXPECT_TRUE(record.add(bot.pick_action(record.final_position())));
+  return record;
+}
+
+} // namespace
+
+// Every seek lands on the position reached by replaying from the start
+TEST(GameRecord, SeekMatchesReplay) {
+  GameRecord record = random_game(150, 7);
+  Board replay(9);
+  for (int m = 0; m <= record.num_moves(); m++) {
+    Board seek = record.position(m);
+    EXPECT_EQ(seek.hash(), replay.hash()) << "move " << m;
+    EXPECT_EQ(seek.to_play(), replay.to_play());
+    EXPECT_EQ(seek.phase(), replay.phase());
+    EXPECT_EQ(seek.ko_point(), replay.ko_point());
+    if (m < record.num_moves())
+      replay.apply(record.actions()[m]);
+  }
+  EXPECT_EQ(record.final_position().hash(), replay.hash());
+}
+
+// Illegal actions and actions after the game ended are refused
+TEST(GameRecord, RejectsIllegalActions) {
+  GameRecord record(5);
+  ASSERT_TRUE(record.add(Action::place({2, 2})));
+  EXPECT_FALSE(record.add(Action::place({2, 2})));
+  EXPECT_EQ(record.num_moves(), 1);
+
+  GameRecord over(5);
+  ASSERT_TRUE(over.add(Action::pass()));
+  ASSERT_TRUE(over.add(Action::pass()));
+  ASSERT_TRUE(over.final_position().game_over());
+  EXPECT_FALSE(over.add(Action::pass()));
+}
+
+// Records survive a round trip through the text format
+TEST(GameRecord, RoundTrip) {
+  std::vector<GameRecord> games{random_game(80, 32), GameRecord(13, 0.5)};
+  std::stringstream file;
+  file << "# two games\n\n";
+  for (const auto &g : games)
+    write_record(file, g);
+
+  auto loaded = read_records(file);
+  ASSERT_EQ(loaded.size(), 2u);
+  EXPECT_EQ(loaded[0].actions(), games[0].actions());
+  EXPECT_EQ(loaded[0].komi(), 6.5);
+  EXPECT_EQ(loaded[0].final_position().hash(),
+            games[0].final_position().hash());
+  EXPECT_EQ(loaded[1].board_size(), 13);
+  EXPECT_EQ(loaded[1].komi(), 0.5);
+  EXPECT_EQ(loaded[1].num_moves(), 0);
+}
+
+// Malformed lines are reported, not skipped
+TEST(GameRecord, RejectsMalformedFiles) {
+  for (const char *text : {"9\n", "9 6.5 81 x\n", "9 6.5 82\n",
+                           "9 6.5 40 40\n", "25 6.5\n"}) {
+    std::istringstream in(text);
+    EXPECT_THROW(read_records(in), std::runtime_error) << text;
+  }
+}
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include "double-go/double-go.h"
+#include "double-go/match.h"
+#include "double-go/rollout.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <random>
+
+using namespace double_go;
+
+// ===== FenwickSampler =====
+
+// Totals track updates and find() lands in the right slot
+TEST(FenwickSampler, FindsByCumulativeWeight) {
+  FenwickSampler s(5);
+  s.set(0, 1.0);
+  s.set(2, 2.0);
+  s.set(4, 3.0);
+  EXPECT_DOUBLE_EQ(s.total(), 6.0);
+  EXPECT_EQ(s.find(0.0), 0);
+  EXPECT_EQ(s.find(0.999), 0);
+  EXPECT_EQ(s.find(1.0), 2);
+  EXPECT_EQ(s.find(2.999), 2);
+  EXPECT_EQ(s.find(3.0), 4);
+  EXPECT_EQ(s.find(5.999), 4);
+
+  s.set(2, 0.0);
+  EXPECT_DOUBLE_EQ(s.total(), 4.0);
+  EXPECT_EQ(s.find(1.0), 4);
+}
+
+// Past the end or with nothing left, find() degrades gracefully
+TEST(FenwickSampler, Bounds) {
+  FenwickSampler s(3);
+  EXPECT_EQ(s.find(0.0), -1);
+  s.set(1, 1.0);
+  EXPECT_EQ(s.find(1.5), 1);
+}
+
+// Sampled frequencies follow the weights
+TEST(FenwickSampler, Distribution) {
+  FenwickSampler s(4);
+  s.set(0, 1.0);
+  s.set(3, 3.0);
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<double> u(0.0, s.total());
+  int hits[4] = {};
+  for (int i = 0; i < 10000; i++)
+    ++hits[s.find(u(rng))];
+  EXPECT_EQ(hits[1] + hits[2], 0);
+  EXPECT_NEAR(hits[3] / 10000.0, 0.75, 0.02);
+}
+
+// ===== RolloutBot =====
+
+// Picks legal moves and never fills its own eye
+TEST(RolloutBot, AvoidsOwnEyes) {
+  Board b(3);
+  // Black owns the board except (0,0), which is a black eye.
+  for (Point p : std::vector<Point>{{0, 1}, {1, 0}, {1, 1}, {0, 2},
+                                    {2, 0}, {1, 2}, {2, 1}, {2, 2}}) {
+    b.play_single(p);
+    b.pass();
+  }
+  ASSERT_EQ(b.to_play(), Color::Black);
+  RolloutBot bot(nullptr, 1);
+  for (int i = 0; i < 20; i++)
+    EXPECT_EQ(bot.pick_action(b).type, ActionType::Pass);
+}
+
+// Playouts end the game and are reproducible from the seed
+TEST(RolloutBot, PlayoutFinishesDeterministically) {
+  RolloutBot a(nullptr, 7), b(nullptr, 7);
+  Board start(9);
+  Board end_a = a.playout(start, 1000);
+  Board end_b = b.playout(start, 1000);
+  EXPECT_TRUE(end_a.game_over());
+  EXPECT_EQ(end_a.hash(), end_b.hash());
+}
+
+// Playouts leave a shared superko history untouched
+TEST(RolloutBot, PlayoutRollsBackSuperko) {
+  Board b(7);
+  b.enable_superko(SuperkoRule::Situational);
+  size_t before = b.position_history()->size();
+  RolloutBot bot(nullptr, 3);
+  Board end = bot.playout(b, 500);
+  EXPECT_GT(end.hash(), 0u);
+  EXPECT_EQ(b.position_history()->size(), before);
+}
+
+// The pattern policy beats uniform random play
+TEST(RolloutBot, BeatsRandom) {
+  auto weights =
+      std::make_shared<const RolloutWeights>(RolloutWeights::defaults());
+  PlayerFactory rollout = [weights](unsigned seed, double) -> Player {
+    auto bot = std::make_shared<RolloutBot>(weights, seed);
+    return [bot](const std::deque<Board> &h) {
+      return bot->pick_action(h.back());
+    };
+  };
+  PlayerFactory random = [](unsigned seed, double) -> Player {
+    auto bot = std::make_shared<RandomBot>(seed);
+    return [bot](const std::deque<Board> &h) {
+      return bot->pick_action(h.back());
+    };
+  };
+  MatchConfig config;
+  config.board_size = 7;
+  config.num_games = 40;
+  config.num_threads = 2;
+  config.seed = 11;
+  MatchSummary summary;
+  run_match(rollout, random, config, [&](const MatchGame &g) {
+    summary.add(g);
+    return true;
+  });
+  EXPECT_GT(summary.wins, 30);
+}
+
+// ===== RolloutWeights =====
+
+// Repeated steps on one example raise its likelihood
+TEST(RolloutWeights, TrainStepReducesLoss) {
+  Board b(5);
+  b.play_single({2, 2});
+  RolloutWeights w = RolloutWeights::defaults();
+  auto first = w.train_step(b, {1, 2}, 0.5);
+  ASSERT_TRUE(first.has_value());
+  double last = *first;
+  for (int i = 0; i < 20; i++)
+    last = *w.train_step(b, {1, 2}, 0.5);
+  EXPECT_LT(last, *first);
+  // Occupied points are not candidates
+  EXPECT_FALSE(w.train_step(b, {2, 2}, 0.5).has_value());
+}
+
+// Weights survive a save/load round trip
+TEST(RolloutWeights, SaveLoadRoundTrip) {
+  RolloutWeights w = RolloutWeights::defaults();
+  w.pattern[1234] = 0.5f;
+  w.self_atari = -1.25f;
+  auto path = std::filesystem::temp_directory_path() / "rollout_test.dgr";
+  w.save(path.string());
+  RolloutWeights loaded = RolloutWeights::load(path.string());
+  std::filesystem::remove(path);
+  EXPECT_EQ(loaded.pattern, w.pattern);
+  EXPECT_FLOAT_EQ(loaded.capture, w.capture);
+  EXPECT_FLOAT_EQ(loaded.self_atari, -1.25f);
+  EXPECT_THROW(RolloutWeights::load(path.string()), std::runtime_error);
+}
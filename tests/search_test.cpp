@@ -0,0 +1,378 @@
+#include <gtest/gtest.h>
+
+#include "double-go/double-go.h"
+#include "double-go/match.h"
+#include "double-go/search.h"
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <set>
+
+using namespace double_go;
+
+namespace {
+
+// Flat priors and a neutral value, counting calls.
+class UniformEvaluator : public Evaluator {
+public:
+  Evaluation evaluate(const std::deque<Board> &history) override {
+    ++calls;
+    int n = history.back().size() * history.back().size() + 1;
+    return {std::vector<float>(n, 1.0f), 0.0f};
+  }
+  int calls = 0;
+};
+
+// 3x3 with a black wall down the middle column, White having just passed:
+// if Black passes too, the game ends 9 to komi.
+Board black_wall() {
+  Board b(3);
+  b.play_single({0, 1});
+  b.pass();
+  b.play_single({1, 1});
+  b.pass();
+  b.play_single({2, 1});
+  b.pass();
+  return b;
+}
+
+} // namespace
+
+// ===== SearchTree =====
+
+// Half precision keeps 11 significant bits and rounds to nearest
+TEST(SearchTree, HalfPrecision) {
+  for (float f : {0.0f, 1.0f, 0.5f, 0.25f, 2048.0f, 65504.0f, -3.0f})
+    EXPECT_EQ(half_to_float(float_to_half(f)), f);
+  for (float f : {1.0f / 3, 0.01f, 1e-3f, 0.999f})
+    EXPECT_NEAR(half_to_float(float_to_half(f)), f, f / 2048);
+  // Subnormals down to 2^-24, then zero; overflow goes to infinity
+  EXPECT_EQ(half_to_float(float_to_half(0x1p-24f)), 0x1p-24f);
+  EXPECT_NEAR(half_to_float(float_to_half(1e-6f)), 1e-6f, 0x1p-25f);
+  EXPECT_EQ(half_to_float(float_to_half(1e-9f)), 0.0f);
+  EXPECT_TRUE(std::isinf(half_to_float(float_to_half(1e6f))));
+  // Ties go to even
+  EXPECT_EQ(float_to_half(1.0f + 0x1p-11f), float_to_half(1.0f));
+  EXPECT_EQ(float_to_half(1.0f + 3 * 0x1p-11f),
+            float_to_half(1.0f + 0x1p-9f));
+}
+
+// Edge arrays are contiguous, never straddle a chunk, and children appear
+// only when asked for
+TEST(SearchTree, ArenaLayout) {
+  SearchTree tree;
+  EXPECT_EQ(tree.num_nodes(), 1u);
+  tree.allocate_edges(0, 362);
+  const auto &root = tree.node(0);
+  EXPECT_EQ(root.num_edges, 362);
+  EXPECT_EQ(tree.num_nodes(), 1u);
+
+  uint32_t e = root.first_edge + 7;
+  uint32_t c = tree.child(e);
+  EXPECT_NE(c, SearchTree::NO_NODE);
+  EXPECT_EQ(tree.child(e), c);
+  EXPECT_EQ(tree.num_nodes(), 2u);
+
+  // Fill most of the first chunk, then ask for more than is left
+  uint32_t filler = tree.add_node();
+  tree.allocate_edges(filler, SearchTree::MAX_EDGES - 400);
+  uint32_t next = tree.add_node();
+  tree.allocate_edges(next, 100);
+  EXPECT_EQ(tree.node(next).first_edge, SearchTree::MAX_EDGES);
+  EXPECT_EQ(tree.bytes(), tree.num_nodes() * sizeof(SearchTree::Node) +
+                              tree.num_edges() * sizeof(SearchTree::Edge));
+  EXPECT_THROW(tree.allocate_edges(next, SearchTree::MAX_EDGES),
+               std::length_error);
+
+  tree.clear();
+  EXPECT_EQ(tree.num_nodes(), 1u);
+  EXPECT_EQ(tree.num_edges(), 0u);
+  EXPECT_EQ(tree.node(0).num_edges, 0);
+}
+
+// ===== Search =====
+
+// Every simulation but the one expanding the root lands on a root edge
+TEST(Search, VisitAccounting) {
+  auto evaluator = std::make_shared<UniformEvaluator>();
+  SearchConfig config;
+  config.visits = 50;
+  Search search(evaluator, config);
+  auto result = search.run({Board(5)});
+  EXPECT_EQ(result.visits, 49);
+  // Fewer calls if a simulation ended the game with two passes
+  EXPECT_LE(evaluator->calls, 50);
+  int sum = 0;
+  float prior = 0.0f;
+  for (const auto &c : result.children) {
+    sum += c.visits;
+    prior += c.prior;
+    EXPECT_FALSE(c.second.has_value());
+  }
+  EXPECT_EQ(sum, 49);
+  EXPECT_NEAR(prior, 1.0f, 1e-3); // half precision
+  EXPECT_EQ(result.children.size(), 26u);
+  EXPECT_GE(result.children.front().visits, result.children.back().visits);
+
+  // One node per simulation at most, each expanded one with its edges
+  EXPECT_LE(result.tree_nodes, 51u);
+  EXPECT_GE(result.tree_edges, 26u);
+  EXPECT_EQ(result.tree_bytes,
+            result.tree_nodes * sizeof(SearchTree::Node) +
+                result.tree_edges * sizeof(SearchTree::Edge));
+
+  // The tree is rebuilt, not extended, by the next run
+  auto again = search.run({Board(5)});
+  EXPECT_EQ(again.tree_nodes, result.tree_nodes);
+}
+
+// Terminal values reach the root from the side that chose the edge: Black
+// passes to end a won game and keeps playing in a lost one
+TEST(Search, EdgeValuesFollowTheChooser) {
+  Board b = black_wall();
+  ASSERT_EQ(b.to_play(), Color::Black);
+  ASSERT_EQ(b.consecutive_passes(), 1);
+
+  SearchConfig config;
+  config.visits = 100;
+  config.komi = 0.5;
+  Search winning(std::make_shared<UniformEvaluator>(), config);
+  auto won = winning.run({b});
+  EXPECT_EQ(won.children.front().first.type, ActionType::Pass);
+  EXPECT_FLOAT_EQ(won.children.front().q, 1.0f);
+
+  config.komi = 9.5;
+  Search losing(std::make_shared<UniformEvaluator>(), config);
+  auto lost = losing.run({b});
+  EXPECT_EQ(lost.children.front().first.type, ActionType::Place);
+  for (const auto &c : lost.children) {
+    if (c.first.type == ActionType::Pass) {
+      EXPECT_FLOAT_EQ(c.q, -1.0f);
+    }
+  }
+}
+
+// With early stop, a search whose leader can no longer be caught ends
+// there, playing the move the full search would
+TEST(Search, EarlyStopSavesVisits) {
+  SearchConfig config;
+  config.visits = 400;
+  config.komi = 0.5;
+  auto full = Search(std::make_shared<UniformEvaluator>(), config)
+                  .run({black_wall()});
+  EXPECT_EQ(full.saved_visits, 0);
+
+  config.early_stop = true;
+  auto early = Search(std::make_shared<UniformEvaluator>(), config)
+                   .run({black_wall()});
+  EXPECT_GT(early.saved_visits, 0);
+  EXPECT_EQ(early.visits + early.saved_visits, full.visits);
+  EXPECT_EQ(early.children.front().first, full.children.front().first);
+  EXPECT_GT(early.children[0].visits - early.children[1].visits,
+            early.saved_visits);
+}
+
+// Sequential halving gives the considered edges equal visits each round
+// and doubles the survivors' share
+TEST(Search, GumbelHalvesCandidates) {
+  SearchConfig config;
+  config.visits = 65;
+  config.root_policy = RootPolicy::Gumbel;
+  config.gumbel_considered = 4;
+  config.seed = 5;
+  Search search(std::make_shared<UniformEvaluator>(), config);
+  auto result = search.run({Board(5)});
+  std::vector<int> visits;
+  for (const auto &c : result.children)
+    if (c.visits)
+      visits.push_back(c.visits);
+  EXPECT_EQ(visits, (std::vector<int>{24, 24, 8, 8}));
+
+  // The same seed considers the same edges
+  auto again = Search(std::make_shared<UniformEvaluator>(), config)
+                   .run({Board(5)});
+  for (size_t i = 0; i < 4; i++)
+    EXPECT_EQ(again.children[i].first, result.children[i].first);
+}
+
+// The Gumbel survivor is played, and the improved policy moves towards the
+// edges that won
+TEST(Search, GumbelFindsWinAndImprovesPolicy) {
+  SearchConfig config;
+  config.visits = 32;
+  config.komi = 0.5;
+  config.root_policy = RootPolicy::Gumbel;
+  config.seed = 9;
+  Search search(std::make_shared<UniformEvaluator>(), config);
+  auto result = search.run({black_wall()});
+  const SearchChild &best = result.children.front();
+  EXPECT_EQ(best.first.type, ActionType::Pass);
+  EXPECT_EQ(result.pv.front(), best.first);
+  float sum = 0.0f;
+  for (const auto &c : result.children) {
+    sum += c.improved;
+    EXPECT_LE(c.improved, best.improved);
+  }
+  EXPECT_NEAR(sum, 1.0f, 1e-4);
+  EXPECT_GT(best.improved, 0.5f);
+}
+
+// Macro-actions: a First-phase root has the single pass plus at most
+// first x second pairs, each reaching a different position
+TEST(Search, MacroActionsArePrunedPairs) {
+  SearchConfig config;
+  config.visits = 20;
+  config.macro_actions = true;
+  config.macro_first = 4;
+  config.macro_second = 3;
+  Search search(std::make_shared<UniformEvaluator>(), config);
+  Board root(5);
+  auto result = search.run({root});
+
+  ASSERT_LE(result.children.size(), 1u + 4 * 3);
+  std::set<uint64_t> reached;
+  float prior = 0.0f;
+  for (const auto &c : result.children) {
+    prior += c.prior;
+    Board b = root;
+    ASSERT_TRUE(b.apply(c.first));
+    if (c.first.type == ActionType::Pass) {
+      EXPECT_FALSE(c.second.has_value());
+    } else {
+      ASSERT_TRUE(c.second.has_value());
+      ASSERT_TRUE(b.apply(*c.second));
+    }
+    EXPECT_TRUE(reached.insert(b.hash()).second);
+  }
+  EXPECT_NEAR(prior, 1.0f, 1e-3); // half precision
+
+  // Second-phase positions are searched one stone at a time
+  Board second = root;
+  second.apply(Action::place({2, 2}));
+  for (const auto &c : search.run({root, second}).children)
+    EXPECT_FALSE(c.second.has_value());
+}
+
+// The observer sees the search grow and finally the result run() returns,
+// whose principal variation starts with the most visited root edge
+TEST(Search, ObserverSeesProgress) {
+  SearchConfig config;
+  config.visits = 200;
+  Search search(std::make_shared<RolloutEvaluator>(nullptr, 6.5, 4), config);
+  std::vector<SearchResult> seen;
+  search.set_observer([&](const SearchResult &r) { seen.push_back(r); },
+                      std::chrono::milliseconds(0));
+  auto result = search.run({Board(5)});
+
+  ASSERT_GE(seen.size(), 2u);
+  for (size_t i = 1; i < seen.size(); i++)
+    EXPECT_GE(seen[i].visits, seen[i - 1].visits);
+  EXPECT_EQ(seen.back().visits, result.visits);
+  EXPECT_EQ(seen.back().pv, result.pv);
+  ASSERT_FALSE(result.pv.empty());
+  EXPECT_EQ(result.pv.front(), result.children.front().first);
+
+  // The variation is playable from the root
+  Board b(5);
+  for (Action a : result.pv)
+    EXPECT_TRUE(b.apply(a));
+}
+
+// A deadline cuts the search short but still expands the root
+TEST(Search, StopsAtDeadline) {
+  SearchConfig config;
+  config.visits = 1 << 30;
+  Search search(std::make_shared<RolloutEvaluator>(nullptr, 6.5, 2), config);
+  auto start = std::chrono::steady_clock::now();
+  auto result = search.run({Board(9)}, start + std::chrono::milliseconds(50));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+  EXPECT_LT(result.visits, config.visits);
+  EXPECT_FALSE(result.children.empty());
+
+  auto expired = search.run({Board(9)}, start);
+  EXPECT_EQ(expired.visits, 0);
+  EXPECT_EQ(expired.children.size(), 82u);
+}
+
+// The stop check sees the root race after every simulation and ends the
+// search when it says so
+TEST(Search, StopCheckEndsSearch) {
+  SearchConfig config;
+  config.visits = 1000;
+  Search search(std::make_shared<RolloutEvaluator>(nullptr, 6.5, 3), config);
+  int checks = 0;
+  search.set_stop_check([&](const SearchProgress &p) {
+    EXPECT_EQ(p.visits, checks);
+    EXPECT_EQ(p.children, 26);
+    EXPECT_GE(p.best_visits, p.second_visits);
+    EXPECT_LE(p.best_visits + p.second_visits, p.visits);
+    checks++;
+    return p.visits == 40;
+  });
+  auto result = search.run({Board(5)});
+  EXPECT_EQ(result.visits, 40);
+  EXPECT_EQ(checks, 41);
+}
+
+// Simulations leave a shared superko history as they found it
+TEST(Search, RollsBackSuperko) {
+  Board b(5);
+  b.enable_superko(SuperkoRule::Situational);
+  b.play_single({1, 1});
+  size_t before = b.position_history()->size();
+  SearchConfig config;
+  config.visits = 64;
+  config.macro_actions = true;
+  Search search(std::make_shared<RolloutEvaluator>(nullptr, 6.5, 5), config);
+  search.run({b});
+  EXPECT_EQ(b.position_history()->size(), before);
+}
+
+// ===== MctsBot =====
+
+// With macro-actions the bot plays out a whole game legally, including the
+// planned second stones
+TEST(MctsBot, PlaysLegalGame) {
+  SearchConfig config;
+  config.visits = 24;
+  config.macro_actions = true;
+  MctsBot bot(std::make_shared<RolloutEvaluator>(nullptr, 6.5, 9), config);
+  std::deque<Board> history{Board(5)};
+  for (int m = 0; m < 300 && !history.back().game_over(); m++) {
+    Board next = history.back();
+    ASSERT_TRUE(next.apply(bot.pick_action(history)));
+    history.push_back(std::move(next));
+  }
+  EXPECT_TRUE(history.back().game_over());
+}
+
+// Search on rollout evaluations beats uniform random play
+TEST(MctsBot, BeatsRandom) {
+  PlayerFactory mcts = [](unsigned seed, double komi) -> Player {
+    SearchConfig config;
+    config.visits = 32;
+    config.komi = komi;
+    auto bot = std::make_shared<MctsBot>(
+        std::make_shared<RolloutEvaluator>(nullptr, komi, seed), config);
+    return [bot](const std::deque<Board> &h) { return bot->pick_action(h); };
+  };
+  PlayerFactory random = [](unsigned seed, double) -> Player {
+    auto bot = std::make_shared<RandomBot>(seed);
+    return [bot](const std::deque<Board> &h) {
+      return bot->pick_action(h.back());
+    };
+  };
+  MatchConfig config;
+  config.board_size = 5;
+  config.num_games = 12;
+  config.num_threads = 2;
+  config.seed = 3;
+  MatchSummary summary;
+  run_match(mcts, random, config, [&](const MatchGame &g) {
+    summary.add(g);
+    return true;
+  });
+  EXPECT_GE(summary.wins, 10);
+}
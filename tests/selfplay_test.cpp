@@ -0,0 +1,263 @@
+#include <gtest/gtest.h>
+
+#include "double-go/selfplay.h"
+
+#include <random>
+
+using namespace double_go;
+
+// ===== Action Sampling =====
+
+// Greedy sampling picks the highest legal logit
+TEST(SampleAction, GreedyPicksBestLegal) {
+  Board b(5);
+  b.apply(Action::place({2, 2}));
+  auto logits = torch::zeros({5 * 5 + 1});
+  logits[action_index(Action::place({2, 2}), 5)] = 10.0f; // occupied
+  logits[action_index(Action::place({1, 1}), 5)] = 5.0f;
+
+  std::mt19937 rng(0);
+  EXPECT_EQ(sample_action(logits, b, 0.0, rng), Action::place({1, 1}));
+}
+
+// Sampling never returns an illegal action
+TEST(SampleAction, NeverIllegal) {
+  Board b(5);
+  b.apply(Action::place({0, 0}));
+  auto logits = torch::zeros({5 * 5 + 1});
+  logits[0] = 100.0f;
+
+  std::mt19937 rng(0);
+  for (int i = 0; i < 100; ++i) {
+    Action a = sample_action(logits, b, 1.0, rng);
+    EXPECT_NE(a, Action::place({0, 0}));
+  }
+}
+
+// ===== Weight Copying =====
+
+// Copied model produces identical outputs
+TEST(CopyWeights, IdenticalOutputs) {
+  Model src(5, 1, 8);
+  Model dst(5, 1, 8);
+  src.eval();
+  dst.eval();
+  copy_weights(src, dst);
+
+  std::deque<Board> history{Board(5)};
+  auto input = src.encode(history).unsqueeze(0);
+  auto [p1, v1] = src.forward(input);
+  auto [p2, v2] = dst.forward(input);
+  EXPECT_TRUE(torch::equal(p1, p2));
+  EXPECT_TRUE(torch::equal(v1, v2));
+}
+
+// ===== ModelSlot =====
+
+// Publishing bumps the generation and swaps in the new weights
+TEST(ModelSlot, PublishSwapsWeights) {
+  Model initial(5, 1, 8);
+  ModelSlot slot(initial);
+  EXPECT_EQ(slot.generation(), 0u);
+
+  Model trained(5, 1, 8);
+  slot.publish(trained);
+  EXPECT_EQ(slot.generation(), 1u);
+
+  auto lease = slot.acquire();
+  EXPECT_EQ(lease.generation(), 1u);
+  EXPECT_TRUE(torch::equal(lease.model().conv->weight, trained.conv->weight));
+}
+
+// A lease keeps its weights while newer generations are published
+TEST(ModelSlot, LeaseSurvivesPublish) {
+  Model initial(5, 1, 8);
+  ModelSlot slot(initial);
+  auto lease = slot.acquire();
+
+  Model trained(5, 1, 8);
+  slot.publish(trained);
+
+  EXPECT_EQ(lease.generation(), 0u);
+  EXPECT_TRUE(torch::equal(lease.model().conv->weight, initial.conv->weight));
+  EXPECT_EQ(slot.acquire().generation(), 1u);
+}
+
+// ===== ReplayBuffer =====
+
+// Buffer stops growing at capacity but keeps counting
+TEST(ReplayBuffer, WrapsAtCapacity) {
+  ReplayBuffer buffer(4);
+  std::vector<TrainingSample> samples;
+  for (int i = 0; i < 6; ++i) {
+    samples.push_back({torch::zeros({20, 5, 5}), torch::zeros({26}),
+                       static_cast<float>(i)});
+  }
+  buffer.add(std::move(samples));
+  EXPECT_EQ(buffer.size(), 4u);
+  EXPECT_EQ(buffer.total_added(), 6u);
+}
+
+// Sampled batch has stacked shapes
+TEST(ReplayBuffer, SampleShapes) {
+  ReplayBuffer buffer(8);
+  std::vector<TrainingSample> samples;
+  for (int i = 0; i < 3; ++i) {
+    samples.push_back({torch::zeros({20, 5, 5}), torch::zeros({26}), 1.0f});
+  }
+  buffer.add(std::move(samples));
+
+  std::mt19937 rng(0);
+  auto [enc, pol, val] = buffer.sample(16, rng);
+  EXPECT_EQ(enc.dim(), 4);
+  EXPECT_EQ(enc.size(0), 16);
+  EXPECT_EQ(enc.size(1), 20);
+  EXPECT_EQ(pol.size(0), 16);
+  EXPECT_EQ(pol.size(1), 26);
+  EXPECT_EQ(val.dim(), 1);
+  EXPECT_EQ(val.size(0), 16);
+}
+
+// ===== Policy Targets =====
+
+// A searched move's target is each root child's improved policy
+TEST(ImprovedPolicyTarget, MatchesChildren) {
+  SearchConfig config;
+  config.visits = 16;
+  config.root_policy = RootPolicy::Gumbel;
+  Search search(std::make_shared<RolloutEvaluator>(nullptr, 6.5, 1), config);
+  std::deque<Board> history{Board(5)};
+  SearchResult result = search.run(history);
+  ASSERT_FALSE(result.children.empty());
+
+  Tensor target = improved_policy_target(result, 5);
+  ASSERT_EQ(target.size(0), 26);
+  std::vector<bool> is_child(26, false);
+  for (const auto &child : result.children) {
+    int k = action_index(child.first, 5);
+    is_child[k] = true;
+    EXPECT_FLOAT_EQ(target[k].item<float>(), child.improved);
+  }
+  for (int k = 0; k < 26; ++k) {
+    if (!is_child[k])
+      EXPECT_EQ(target[k].item<float>(), 0.0f);
+  }
+  EXPECT_NEAR(target.sum().item<float>(), 1.0f, 1e-4);
+}
+
+// ===== Pipeline =====
+
+// Workers produce games and the trainer publishes each generation
+TEST(Pipeline, RunsGenerations) {
+  auto model = std::make_shared<Model>(5, 1, 8);
+  SelfPlayConfig self_play;
+  self_play.num_workers = 2;
+  self_play.games_per_batch = 4;
+  self_play.max_moves = 40;
+  TrainerConfig trainer;
+  trainer.batch_size = 16;
+  trainer.steps_per_generation = 2;
+  trainer.min_samples = 64;
+
+  Pipeline pipeline(model, self_play, trainer);
+  int callbacks = 0;
+  pipeline.run(2, [&](const PipelineStats &stats, const Model &) {
+    ++callbacks;
+    EXPECT_EQ(stats.generation, static_cast<uint64_t>(callbacks));
+  });
+
+  EXPECT_EQ(callbacks, 2);
+  EXPECT_GT(pipeline.stats().games, 0u);
+  EXPECT_GE(pipeline.stats().samples, 64u);
+}
+
+// A threshold every evaluation falls below makes every game resign
+TEST(Pipeline, ResignsBelowThreshold) {
+  auto model = std::make_shared<Model>(5, 1, 8);
+  SelfPlayConfig self_play;
+  self_play.num_workers = 1;
+  self_play.games_per_batch = 4;
+  self_play.max_moves = 40;
+  self_play.resign_threshold = 2.0;
+  self_play.resign_consecutive = 2;
+  self_play.resign_disabled_fraction = 0.0;
+  TrainerConfig trainer;
+  trainer.batch_size = 8;
+  trainer.steps_per_generation = 1;
+  trainer.min_samples = 16;
+
+  Pipeline pipeline(model, self_play, trainer);
+  pipeline.run(1);
+
+  auto stats = pipeline.stats();
+  EXPECT_GT(stats.games, 0u);
+  EXPECT_EQ(stats.resigned, stats.games);
+  EXPECT_EQ(stats.resign_checked, 0u);
+}
+
+// With resignation disabled, would-be resignations are tracked instead
+TEST(Pipeline, DisabledResignCalibration) {
+  auto model = std::make_shared<Model>(5, 1, 8);
+  SelfPlayConfig self_play;
+  self_play.num_workers = 1;
+  self_play.games_per_batch = 4;
+  self_play.max_moves = 20;
+  self_play.resign_threshold = 2.0;
+  self_play.resign_disabled_fraction = 1.0;
+  TrainerConfig trainer;
+  trainer.batch_size = 8;
+  trainer.steps_per_generation = 1;
+  trainer.min_samples = 16;
+
+  Pipeline pipeline(model, self_play, trainer);
+  pipeline.run(1);
+
+  auto stats = pipeline.stats();
+  EXPECT_EQ(stats.resigned, 0u);
+  EXPECT_GT(stats.resign_checked, 0u);
+  EXPECT_LE(stats.resign_false_positives, stats.resign_checked);
+}
+
+// Searched self-play stores the improved policy, a distribution
+TEST(Pipeline, SearchTargetsAreDistributions) {
+  auto model = std::make_shared<Model>(5, 1, 8);
+  SelfPlayConfig self_play;
+  self_play.num_workers = 1;
+  self_play.games_per_batch = 2;
+  self_play.max_moves = 20;
+  self_play.search_visits = 4;
+  self_play.search_considered = 4;
+  TrainerConfig trainer;
+  trainer.batch_size = 8;
+  trainer.steps_per_generation = 1;
+  trainer.min_samples = 16;
+
+  Pipeline pipeline(model, self_play, trainer);
+  pipeline.run(1);
+
+  std::mt19937 rng(0);
+  auto [encodings, policies, values] = pipeline.buffer().sample(32, rng);
+  EXPECT_GE(policies.min().item<float>(), 0.0f);
+  EXPECT_TRUE(torch::allclose(policies.sum(1), torch::ones({32}), 1e-4, 1e-4));
+}
+
+// Without search the samples carry no policy target
+TEST(Pipeline, NoSearchTargetsAreZero) {
+  auto model = std::make_shared<Model>(5, 1, 8);
+  SelfPlayConfig self_play;
+  self_play.num_workers = 1;
+  self_play.games_per_batch = 4;
+  self_play.max_moves = 20;
+  self_play.search_visits = 0;
+  TrainerConfig trainer;
+  trainer.batch_size = 8;
+  trainer.steps_per_generation = 1;
+  trainer.min_samples = 16;
+
+  Pipeline pipeline(model, self_play, trainer);
+  pipeline.run(1);
+
+  std::mt19937 rng(0);
+  auto [encodings, policies, values] = pipeline.buffer().sample(32, rng);
+  EXPECT_EQ(policies.abs().sum().item<float>(), 0.0f);
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include "double-go/double-go.h"
+#include "double-go/sgf.h"
+
+#include <sstream>
+#include <stdexcept>
+
+using namespace double_go;
+
+namespace {
+
+GameRecord random_game(int size, unsigned seed) {
+  GameRecord record(size, 7.5);
+  RandomBot bot(seed);
+  while (!record.final_position().game_over())
+    EXPECT_TRUE(record.add(bot.pick_action(record.final_position())));
+  return record;
+}
+
+// Reads every game in text, rethrowing parse errors.
+std::vector<SgfGame> read_all(const std::string &text) {
+  std::istringstream in(text);
+  SgfReader reader(in, "test.sgf");
+  std::vector<SgfGame> games;
+  for (SgfGame game; reader.next(game);)
+    games.push_back(game);
+  return games;
+}
+
+std::string error_of(const std::string &text) {
+  try {
+    read_all(text);
+  } catch (const std::runtime_error &e) {
+    return e.what();
+  }
+  return "";
+}
+
+} // namespace
+
+// Finished games survive a write and read, result included
+TEST(Sgf, RoundTrip) {
+  std::ostringstream out;
+  SgfWriter writer(out);
+  std::vector<GameRecord> records;
+  for (unsigned seed = 1; seed <= 3; seed++) {
+    records.push_back(random_game(seed == 2 ? 7 : 9, seed));
+    writer.write(records.back());
+  }
+
+  auto games = read_all(out.str());
+  ASSERT_EQ(games.size(), records.size());
+  for (size_t g = 0; g < games.size(); g++) {
+    EXPECT_EQ(games[g].board_size, records[g].board_size());
+    EXPECT_EQ(games[g].komi, 7.5);
+    EXPECT_FALSE(games[g].result.empty());
+    EXPECT_EQ(games[g].actions, records[g].actions());
+    EXPECT_EQ(make_record(games[g]).final_position().hash(),
+              records[g].final_position().hash());
+  }
+}
+
+// Each stone is written with its color and phase
+TEST(Sgf, WritesPhases) {
+  SgfGame game;
+  game.board_size = 5;
+  game.komi = 0.5;
+  game.result = "W+0.5";
+  game.actions = {Action::place({2, 2}), Action::place({0, 0}),
+                  Action::place({4, 4}), Action::pass()};
+  std::ostringstream out;
+  SgfWriter(out).write(game);
+  EXPECT_EQ(out.str(), "(;GM[1]FF[4]CA[UTF-8]AP[double-go]SZ[5]KM[0.5]"
+                       "RE[W+0.5]\n;B[cc]PH[1];B[aa]PH[2];W[ee]PH[b];W[]PH[1])"
+                       "\n");
+
+  game.actions.push_back(Action::place({2, 2}));
+  EXPECT_THROW(SgfWriter(out).write(game), std::runtime_error);
+}
+
+// Only the main line is read; other variations, comments and unknown
+// properties are skipped, escapes included
+TEST(Sgf, FollowsMainLine) {
+  auto games = read_all("(;FF[4]SZ[5]C[a \\] (tricky) comment]\n"
+                        "  ;B[cc] ;B[aa]PH[2]"
+                        "  (;W[bb]PH[b];W[tt]C[pass](;B[dd])(;B[ee]))"
+                        "  (;W[ee]C[(];W[dd]))\n"
+                        "(;SZ[3])");
+  ASSERT_EQ(games.size(), 2u);
+  EXPECT_EQ(games[0].board_size, 5);
+  EXPECT_EQ(games[0].komi, 6.5);
+  EXPECT_EQ(games[0].actions,
+            (std::vector<Action>{Action::place({2, 2}), Action::place({0, 0}),
+                                 Action::place({1, 1}), Action::pass(),
+                                 Action::place({3, 3})}));
+  EXPECT_EQ(games[1].board_size, 3);
+  EXPECT_TRUE(games[1].actions.empty());
+}
+
+// Moves are checked against the board, and errors name the line
+TEST(Sgf, RejectsBadGames) {
+  EXPECT_EQ(error_of("(;SZ[5];W[cc])"),
+            "test.sgf:1: move 1 by the wrong color");
+  EXPECT_EQ(error_of("(;SZ[5]\n;B[cc]PH[2])"),
+            "test.sgf:2: move 1 in the wrong phase");
+  EXPECT_EQ(error_of("(;SZ[5];B[cc];B[cc])"), "test.sgf:1: illegal move 2");
+  EXPECT_EQ(error_of("(;SZ[5];B[cf])"), "test.sgf:1: bad move cf");
+  EXPECT_EQ(error_of("(;SZ[5];B[cc];SZ[9])"),
+            "test.sgf:1: SZ after the first move");
+  EXPECT_EQ(error_of("(;SZ[25])"), "test.sgf:1: unsupported board size 25");
+  EXPECT_EQ(error_of("(;SZ[5]\n;B[cc"),
+            "test.sgf:2: unterminated property value");
+  EXPECT_EQ(error_of("(;SZ[5](;B[cc]"), "test.sgf:1: expected ')'");
+  EXPECT_EQ(error_of("(;SZ[5])x"), "test.sgf:1: expected '('");
+}
+
+// Handicap and set-up stones would replay as a different game
+TEST(Sgf, RejectsSetupStones) {
+  EXPECT_EQ(error_of("(;SZ[9]HA[2]AB[cc][gg];W[ee])"),
+            "test.sgf:1: setup properties are not supported");
+  EXPECT_EQ(error_of("(;SZ[5];B[cc]\n;AW[aa];W[bb])"),
+            "test.sgf:2: setup properties are not supported");
+  EXPECT_EQ(error_of("(;SZ[5];B[cc];AE[cc])"),
+            "test.sgf:1: setup properties are not supported");
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include "double-go/time_manager.h"
+
+using namespace double_go;
+
+namespace {
+
+SearchProgress race(int visits, int best, int best_visits, int second_visits,
+                    float best_q = 0.0f) {
+  SearchProgress p;
+  p.visits = visits;
+  p.children = 10;
+  p.best = best;
+  p.best_visits = best_visits;
+  p.second_visits = second_visits;
+  p.best_q = best_q;
+  return p;
+}
+
+} // namespace
+
+// A turn's time goes mostly to its first stone, and a byo-yomi period's
+// last stone may use the whole period
+TEST(TimeManager, AllocatesByPhase) {
+  TimeManager tm;
+  TimeControl absolute{600, 0, 0};
+  Board b(9);
+  TimeBudget first = tm.allocate(b, absolute, initial_clock(absolute));
+  ASSERT_TRUE(b.apply(Action::place({2, 2})));
+  TimeBudget second = tm.allocate(b, absolute, initial_clock(absolute));
+  EXPECT_GT(first.target, second.target);
+  EXPECT_GE(first.maximum, first.target);
+  EXPECT_LE(first.maximum, 600 * tm.config().max_share);
+  // Together about two even shares of the clock
+  EXPECT_NEAR(first.target + second.target, 2 * 600 / 32.4, 1.5);
+
+  TimeControl byo_yomi{0, 30, 1};
+  TimeBudget last = tm.allocate(b, byo_yomi, {30, 1});
+  EXPECT_LE(last.maximum, 30 - tm.config().overhead);
+  EXPECT_GT(last.maximum, 25);
+  EXPECT_EQ(tm.allocate(b, TimeControl{}, {}).maximum, 0);
+}
+
+// Main time runs into byo-yomi, and a finished period starts another
+TEST(TimeManager, ChargesClock) {
+  TimeControl tc{60, 10, 3};
+  ClockState c = initial_clock(tc);
+  EXPECT_EQ(c.seconds, 60);
+  EXPECT_EQ(c.stones, 0);
+  c = charge(c, tc, 62);
+  EXPECT_EQ(c.seconds, 8);
+  EXPECT_EQ(c.stones, 3);
+  c = charge(c, tc, 1);
+  c = charge(c, tc, 1);
+  EXPECT_EQ(c.seconds, 6);
+  EXPECT_EQ(c.stones, 1);
+  c = charge(c, tc, 5);
+  EXPECT_EQ(c.seconds, 10);
+  EXPECT_EQ(c.stones, 3);
+}
+
+// A settled search stops at its target, or sooner once the leader cannot
+// be caught in the time left
+TEST(TimeManager, StopsSettledSearch) {
+  TimeManager tm;
+  tm.start({10, 25});
+  EXPECT_FALSE(tm.should_stop(race(100, 3, 50, 20), 1));
+  EXPECT_FALSE(tm.should_stop(race(500, 3, 300, 100), 5));
+  EXPECT_TRUE(tm.should_stop(race(1000, 3, 600, 200), 10));
+  EXPECT_EQ(tm.last_stop(), TimeManager::Stop::Target);
+  EXPECT_FALSE(tm.extended());
+
+  tm.start({10, 25});
+  EXPECT_FALSE(tm.should_stop(race(1000, 3, 900, 50), 5));
+  EXPECT_TRUE(tm.should_stop(race(1600, 3, 1500, 60), 8));
+  EXPECT_EQ(tm.last_stop(), TimeManager::Stop::Decided);
+}
+
+// A late change of best edge, or a falling value, extends the search to
+// its maximum
+TEST(TimeManager, ExtendsUnstableSearch) {
+  TimeManager tm;
+  tm.start({10, 25});
+  EXPECT_FALSE(tm.should_stop(race(500, 3, 200, 150), 5));
+  EXPECT_FALSE(tm.should_stop(race(700, 4, 250, 240), 7));
+  EXPECT_FALSE(tm.should_stop(race(1000, 4, 400, 350), 10));
+  EXPECT_TRUE(tm.extended());
+  EXPECT_FALSE(tm.should_stop(race(2000, 4, 900, 800), 20));
+  EXPECT_TRUE(tm.should_stop(race(2500, 4, 1100, 1000), 25));
+  EXPECT_EQ(tm.last_stop(), TimeManager::Stop::Maximum);
+
+  tm.start({10, 25});
+  EXPECT_FALSE(tm.should_stop(race(500, 3, 200, 150, 0.3f), 5));
+  EXPECT_FALSE(tm.should_stop(race(1000, 3, 400, 350, 0.2f), 10));
+  EXPECT_TRUE(tm.extended());
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+
+#include "double-go/triple_buffer.h"
+
+#include <thread>
+#include <vector>
+
+using namespace double_go;
+
+// Nothing to read until the writer publishes, then only the newest value
+TEST(TripleBuffer, ReaderSeesLatest) {
+  TripleBuffer<int> buf;
+  EXPECT_FALSE(buf.update());
+  buf.write_slot() = 1;
+  buf.publish();
+  buf.write_slot() = 2;
+  buf.publish();
+  ASSERT_TRUE(buf.update());
+  EXPECT_EQ(buf.read_slot(), 2);
+  EXPECT_FALSE(buf.update());
+  EXPECT_EQ(buf.read_slot(), 2);
+}
+
+// Under concurrent use the reader never sees a torn or stale value
+TEST(TripleBuffer, ConcurrentHandoff) {
+  constexpr int N = 200000;
+  TripleBuffer<std::vector<int>> buf;
+  std::thread writer([&] {
+    for (int i = 1; i <= N; i++) {
+      auto &slot = buf.write_slot();
+      slot.assign(8, i);
+      buf.publish();
+    }
+  });
+  int last = 0;
+  bool torn = false, backwards = false;
+  while (last < N) {
+    if (!buf.update())
+      continue;
+    const auto &v = buf.read_slot();
+    for (int x : v)
+      torn |= x != v.front();
+    backwards |= v.front() < last;
+    last = v.front();
+  }
+  writer.join();
+  EXPECT_FALSE(torn);
+  EXPECT_FALSE(backwards);
+  EXPECT_EQ(last, N);
+}
@@ -583,3 +583,88 @@ TEST(ZobristHash, PathIndependenceDoubleMoves) {
   EXPECT_EQ(b1.phase(), b2.phase());
   EXPECT_EQ(b1.hash(), b2.hash());
 }
+
+// ===== Incremental vs From-Scratch =====
+
+// Plays random games and checks both hashes after every action.
+static void check_random_games(int size, int games, SuperkoRule superko) {
+  std::mt19937 rng(size * 31 + games);
+  for (int g = 0; g < games; g++) {
+    Board b(size);
+    if (superko != SuperkoRule::None)
+      b.enable_superko(superko);
+    for (int n = 0; n < 4 * size * size && !b.game_over(); n++) {
+      auto actions = b.legal_actions();
+      ASSERT_FALSE(actions.empty());
+      ASSERT_TRUE(b.apply(actions[rng() % actions.size()]));
+      ASSERT_EQ(b.hash(), b.compute_hash()) << "game " << g << " move " << n;
+      ASSERT_EQ(b.stone_hash(), b.compute_stone_hash())
+          << "game " << g << " move " << n;
+    }
+  }
+}
+
+// Empty board hashes match a recomputation
+TEST(ZobristHash, EmptyBoardMatchesRecomputation) {
+  Board b(9);
+  EXPECT_EQ(b.hash(), b.compute_hash());
+  EXPECT_EQ(b.stone_hash(), 0u);
+  EXPECT_EQ(b.compute_stone_hash(), 0u);
+}
+
+// Incremental hashes match a recomputation through random games
+TEST(ZobristHash, RandomGamesMatchRecomputation) {
+  check_random_games(5, 50, SuperkoRule::None);
+  check_random_games(9, 20, SuperkoRule::None);
+  check_random_games(19, 3, SuperkoRule::None);
+}
+
+// Superko bookkeeping leaves the hashes untouched
+TEST(ZobristHash, SuperkoGamesMatchRecomputation) {
+  check_random_games(5, 50, SuperkoRule::Positional);
+  check_random_games(7, 20, SuperkoRule::Situational);
+}
+
+// Stone hash ignores side to move, phase and ko
+TEST(ZobristHash, StoneHashIgnoresState) {
+  Board b1(9);
+  Board b2(9);
+  b1.play_single({3, 3}); // B, White to play
+  b2.apply(Action::place({3, 3})); // B, Black's second move pending
+  EXPECT_NE(b1.hash(), b2.hash());
+  EXPECT_EQ(b1.stone_hash(), b2.stone_hash());
+
+  // Ko setup: same stones with and without a ko point
+  Board ko(9);
+  ko.play_single({0, 1}); // B
+  ko.play_single({0, 2}); // W
+  ko.play_single({1, 0}); // B
+  ko.play_single({1, 3}); // W
+  ko.play_single({2, 1}); // B
+  ko.play_single({2, 2}); // W
+  ko.play_single({8, 8}); // B
+  ko.play_single({1, 1}); // W
+  ko.play_single({1, 2}); // B captures, ko at (1,1)
+  ASSERT_TRUE(ko.ko_point().has_value());
+  uint64_t stones = ko.stone_hash();
+  uint64_t full = ko.hash();
+  ko.play_single({7, 7}); // W elsewhere clears the ko
+  EXPECT_EQ(ko.stone_hash(),
+            stones ^ ZobristHash::get_instance().stone(Color::White, {7, 7}));
+  EXPECT_NE(ko.hash(), full);
+  EXPECT_EQ(ko.hash(), ko.compute_hash());
+}
+
+// Positions reached by different move orders share both hashes
+TEST(ZobristHash, TranspositionSameStoneHash) {
+  Board b1(9);
+  Board b2(9);
+  b1.play_single({2, 2});
+  b1.play_single({6, 6});
+  b1.play_single({2, 6});
+  b2.play_single({2, 6});
+  b2.play_single({6, 6});
+  b2.play_single({2, 2});
+  EXPECT_EQ(b1.stone_hash(), b2.stone_hash());
+  EXPECT_EQ(b1.hash(), b2.hash());
+}